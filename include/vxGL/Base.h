@@ -38,7 +38,9 @@ namespace vx
 			Unsigned_Short = 0x1403,
 			Int = 0x1404,
 			Unsigned_Int = 0x1405,
-			Float = 0x1406
+			Float = 0x1406,
+			Half_Float = 0x140B,
+			Unsigned_Int_2_10_10_10_Rev = 0x8368
 		};
 
 		enum class PrimitveType : u32
@@ -0,0 +1,123 @@
+#pragma once
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/Buffer.h>
+#include <vxLib/Container/sorted_vector.h>
+#include <vector>
+
+namespace vx
+{
+	namespace gl
+	{
+		class Texture;
+
+		struct BindlessTextureTableDescription
+		{
+			u32 capacity;
+			// max number of handles that are resident at the same time
+			u32 residentBudget;
+			// ssbo binding point
+			u32 bindingIndex;
+
+			BindlessTextureTableDescription() :capacity(0), residentBudget(0), bindingIndex(0) {}
+		};
+
+		// Stores bindless texture handles in a shader storage buffer. Every texture gets a stable slot that shaders
+		// can use as index, handles are only made resident when they are requested and the least recently used ones
+		// get evicted when the budget is exceeded. Evicted slots point to the fallback texture.
+		// Residency is reference counted per handle, so a texture can be used by several slots and as fallback.
+		class BindlessTextureTable
+		{
+			static const u32 s_invalidSlot = 0xffffffff;
+
+			struct Entry
+			{
+				u64 handle;
+				u32 textureId;
+				u32 lastUsedFrame;
+				u32 prev;
+				u32 next;
+				u8 resident;
+				u8 used;
+			};
+
+			std::vector<Entry> m_entries;
+			std::vector<u32> m_freeSlots;
+			vx::sorted_vector<u64, u32> m_handleReferences;
+			Buffer m_handleBuffer;
+			u64 m_fallbackHandle;
+			u32 m_lruHead;
+			u32 m_lruTail;
+			u32 m_residentCount;
+			u32 m_residentBudget;
+			u32 m_frame;
+			u32 m_dirtyBegin;
+			u32 m_dirtyEnd;
+			u32 m_bindingIndex;
+
+			void lruRemove(u32 slot);
+			void lruPushFront(u32 slot);
+			void addHandleReference(u64 handle);
+			void releaseHandleReference(u64 handle);
+			void makeResident(u32 slot);
+			void makeNonResident(u32 slot);
+			void evict();
+			void markDirty(u32 slot);
+
+		public:
+			BindlessTextureTable();
+			BindlessTextureTable(const BindlessTextureTable&) = delete;
+			~BindlessTextureTable();
+
+			BindlessTextureTable& operator=(const BindlessTextureTable&) = delete;
+
+			bool initialize(const BindlessTextureTableDescription &desc);
+			void shutdown();
+
+			// fallback must stay valid, its handle is kept resident until shutdown
+			void setFallbackTexture(const Texture &texture);
+
+			// returns the slot of the texture or s_invalidSlot if the table is full
+			u32 addTexture(const Texture &texture);
+			void removeTexture(u32 slot);
+
+			// marks the slot as used in the current frame and makes the handle resident if needed
+			void requestResident(u32 slot);
+
+			// starts a new frame, evicts handles that are over budget and uploads changed slots
+			void update();
+
+			void bind() const;
+
+			u64 getHandle(u32 slot) const;
+			bool isResident(u32 slot) const;
+			u32 getResidentCount() const { return m_residentCount; }
+			u32 getCapacity() const { return static_cast<u32>(m_entries.size()); }
+			const Buffer& getBuffer() const { return m_handleBuffer; }
+
+			static u32 getInvalidSlot() { return s_invalidSlot; }
+		};
+	}
+}
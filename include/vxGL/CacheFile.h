@@ -0,0 +1,44 @@
+#pragma once
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/Base.h>
+#include <string>
+
+namespace vx
+{
+	namespace gl
+	{
+		// fnv-1a, used for cache keys and the checksums of cache files
+		u64 hashFnv1a(const void* data, u64 size, u64 value = 0xcbf29ce484222325ull);
+
+		// Cache files store a header with magic, version, key, size and checksum followed by the data.
+		// They are written to a temporary name and renamed, so readers never see a partial file
+		// and several processes can share a directory.
+		bool writeCacheFile(const std::string &fileName, u32 magic, u32 version, u64 key, const void* data, u64 size);
+
+		// fails if the header does not match, the file is truncated, has trailing data or the checksum is wrong
+		bool readCacheFile(const std::string &fileName, u32 magic, u32 version, u64 key, std::string* data);
+	}
+}
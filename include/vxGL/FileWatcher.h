@@ -0,0 +1,63 @@
+#pragma once
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/Base.h>
+#include <vxLib/Container/sorted_vector.h>
+#include <vxLib/StringID.h>
+#include <string>
+#include <vector>
+
+namespace vx
+{
+	namespace gl
+	{
+		// Tracks the last write time of a set of files, poll reports the files that changed since the previous poll.
+		class FileWatcher
+		{
+			struct Entry
+			{
+				std::string path;
+				u64 writeTime;
+			};
+
+			std::vector<Entry> m_entries;
+			vx::sorted_vector<vx::StringID, u32> m_indices;
+
+		public:
+			FileWatcher();
+			~FileWatcher();
+
+			// returns the index of the file, files are only added once
+			u32 addFile(const std::string &path);
+			void clear();
+
+			// appends the indices of changed files to changed, returns the number of changed files
+			u32 poll(std::vector<u32>* changed);
+
+			const std::string& getPath(u32 index) const { return m_entries[index].path; }
+			u32 getFileCount() const { return static_cast<u32>(m_entries.size()); }
+		};
+	}
+}
\ No newline at end of file
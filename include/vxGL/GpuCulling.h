@@ -0,0 +1,93 @@
+#pragma once
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/Buffer.h>
+#include <vxGL/ShaderProgram.h>
+#include <vxGL/ProgramPipeline.h>
+#include <vxLib/math/Vector.h>
+
+namespace vx
+{
+	namespace gl
+	{
+		// bounding sphere and mesh range of one instance, std430 layout
+		struct GpuCullingInstance
+		{
+			vx::float4 sphere; // xyz center, w radius
+			u32 count;
+			u32 firstIndex;
+			s32 baseVertex;
+			u32 padding;
+		};
+
+		struct GpuCullingView
+		{
+			vx::float4 planes[6]; // normals point inside, dot(n, p) + w >= 0
+			f32 viewProjection[16]; // column major
+			u32 hiZTexture; // farthest depth per texel, 0 disables the occlusion test
+			u32 hiZLevels;
+		};
+
+		// Culls instances against the view frustum and a hi-z pyramid in a compute shader.
+		// Visible instances are compacted into DrawElementsIndirectCommands with an atomic counter,
+		// baseInstance holds the index of the instance.
+		class GpuCulling
+		{
+			ShaderProgram m_program;
+			ProgramPipeline m_pipeline;
+			Buffer m_instanceBuffer;
+			Buffer m_commandBuffer;
+			Buffer m_countBuffer;
+			s32 m_planesLocation;
+			s32 m_viewProjectionLocation;
+			s32 m_instanceCountLocation;
+			s32 m_hiZLevelsLocation;
+			u32 m_maxInstances;
+			u32 m_instanceCount;
+
+		public:
+			GpuCulling();
+			GpuCulling(const GpuCulling&) = delete;
+			~GpuCulling();
+
+			GpuCulling& operator=(const GpuCulling&) = delete;
+
+			bool create(u32 maxInstances);
+			void destroy();
+
+			// instances only need to be uploaded again when they change
+			void setInstances(const GpuCullingInstance* instances, u32 offset, u32 count);
+			void setInstanceCount(u32 count);
+
+			void cull(const GpuCullingView &view);
+			// draws the visible instances with glMultiDrawElementsIndirectCountARB, expects the vao and pipeline to be bound
+			void draw(PrimitveType mode, DataType indexType) const;
+
+			const Buffer& getCommandBuffer() const { return m_commandBuffer; }
+			const Buffer& getCountBuffer() const { return m_countBuffer; }
+			u32 getInstanceCount() const { return m_instanceCount; }
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/TextureFormat.h>
+
+namespace vx
+{
+	namespace gl
+	{
+		struct ImageCompareResult
+		{
+			f64 meanSquaredError;
+			f64 psnr; // in dB, infinite for identical images
+			f32 maxError;
+			u64 differentPixels;
+		};
+
+		// Compares two images of the same size and layout, channel values are normalized to [0, 1]
+		// for unsigned normalized types. Supports Unsigned_Byte, Unsigned_Short, Half_Float and Float data.
+		// If heatmap is not null it receives width * height RGBA8 pixels, black for identical pixels
+		// and ramping from blue to red with the largest channel error of each pixel.
+		bool compareImages(const void* a, const void* b, u32 width, u32 height, TextureFormat format, DataType dataType, ImageCompareResult* result, u8* heatmap = nullptr);
+	}
+}
\ No newline at end of file
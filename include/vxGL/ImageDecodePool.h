@@ -0,0 +1,94 @@
+#pragma once
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/ImageDecoder.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vx
+{
+	namespace gl
+	{
+		struct ImageDecodeResult
+		{
+			DecodedImage image;
+			std::string error;
+			u32 userId;
+			bool success;
+
+			ImageDecodeResult() :image(), error(), userId(0), success(false) {}
+		};
+
+		// Reads and decodes image files on worker threads.
+		// Jobs are pushed from the render thread and finished images are collected with pop,
+		// the upload to the texture has to happen on the thread owning the context.
+		class ImageDecodePool
+		{
+			struct Job
+			{
+				std::string file;
+				u32 userId;
+				bool flipY;
+				bool convert;
+				TextureFormat targetFormat;
+			};
+
+			std::vector<std::thread> m_threads;
+			std::deque<Job> m_jobs;
+			std::vector<ImageDecodeResult> m_results;
+			std::mutex m_jobMutex;
+			std::mutex m_resultMutex;
+			std::condition_variable m_jobCondition;
+			u32 m_pendingJobs;
+			bool m_running;
+
+			void workerMain();
+			void pushJob(Job &&job);
+
+		public:
+			ImageDecodePool();
+			~ImageDecodePool();
+
+			ImageDecodePool(const ImageDecodePool&) = delete;
+			ImageDecodePool& operator=(const ImageDecodePool&) = delete;
+
+			// threadCount of 0 uses one thread less than the hardware concurrency
+			void initialize(u32 threadCount = 0);
+			void shutdown();
+
+			void push(const char* file, u32 userId, bool flipY = false);
+			// also converts the pixels to the transfer layout of targetFormat on the worker thread
+			void push(const char* file, u32 userId, bool flipY, TextureFormat targetFormat);
+
+			// moves all finished results into results, returns the number of results added
+			u32 pop(std::vector<ImageDecodeResult>* results);
+
+			u32 getPendingJobCount();
+		};
+	}
+}
\ No newline at end of file
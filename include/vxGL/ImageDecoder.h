@@ -0,0 +1,81 @@
+#pragma once
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/TextureFormat.h>
+#include <memory>
+#include <string>
+
+namespace vx
+{
+	namespace gl
+	{
+		enum class ImageFileType : u8
+		{
+			Unknown,
+			Png,
+			Tga,
+			Hdr
+		};
+
+		// Decoded pixels in the layout of format, rows are stored top to bottom unless flipped.
+		// 8 bit sources are decoded to R8, RG8 or RGBA8 (rgb is padded with an opaque alpha),
+		// 16 bit png to R16, RG16 or RGBA16 and radiance hdr to RGBA32F.
+		struct DecodedImage
+		{
+			std::unique_ptr<u8[]> data;
+			u64 size;
+			u32 width;
+			u32 height;
+			TextureFormat format;
+			DataType dataType;
+
+			DecodedImage() :data(), size(0), width(0), height(0), format(TextureFormat::RGBA8), dataType(DataType::Unsigned_Byte) {}
+		};
+
+		class Texture;
+
+		class ImageDecoder
+		{
+			ImageDecoder();
+
+		public:
+			static ImageFileType getFileType(const u8* file, u64 fileSize);
+
+			static bool decode(const u8* file, u64 fileSize, bool flipY, DecodedImage* image, std::string* error);
+			static bool decodePng(const u8* file, u64 fileSize, DecodedImage* image, std::string* error);
+			static bool decodeTga(const u8* file, u64 fileSize, DecodedImage* image, std::string* error);
+			static bool decodeHdr(const u8* file, u64 fileSize, DecodedImage* image, std::string* error);
+
+			static void flipVertical(DecodedImage* image);
+
+			// converts the pixels to the transfer layout of target with the PixelConversion kernels,
+			// fails if no conversion exists
+			static bool convert(DecodedImage* image, TextureFormat target, std::string* error);
+
+			// uploads the image into a level and layer of texture, the texture format must match in size
+			static void upload(const Texture &texture, const DecodedImage &image, u32 miplevel, u32 layer);
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#pragma once
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/Buffer.h>
+#include <vector>
+
+namespace vx
+{
+	namespace gl
+	{
+		struct IndirectBatchKey
+		{
+			u32 pipeline;
+			u32 vao;
+			u32 state; // user defined, handed to the state callback when it changes between buckets
+			PrimitveType mode;
+			DataType indexType;
+		};
+
+		typedef void(*IndirectBatchStateCallback)(u32 state, void* userData);
+
+		struct IndirectBatchDescription
+		{
+			u32 maxCommands; // per region of the streaming buffers
+			u32 maxBuckets; // per region of the streaming buffers
+			u32 frameCount; // regions of the streaming buffers, consecutive chunks are written to different regions
+			IndirectBatchStateCallback stateCallback;
+			void* userData;
+			bool useDrawCountBuffer; // draw with glMultiDrawElementsIndirectCountARB, flextInit already requires GL_ARB_indirect_parameters
+
+			IndirectBatchDescription() :maxCommands(4096), maxBuckets(256), frameCount(3), stateCallback(nullptr), userData(nullptr), useDrawCountBuffer(false) {}
+		};
+
+		// Collects DrawElementsIndirectCommands per pipeline, vao and state bucket.
+		// submit streams the commands into a region of a Draw_Indirect_Buffer and draws every bucket with a single multi draw call,
+		// submits that do not fit into one region are flushed in several chunks.
+		class IndirectBatch
+		{
+			struct Bucket
+			{
+				IndirectBatchKey key;
+				std::vector<DrawElementsIndirectCommand> commands;
+			};
+
+			std::vector<Bucket> m_buckets;
+			std::vector<u32> m_order;
+			std::vector<u32> m_chunkBuckets;
+			std::vector<DrawElementsIndirectCommand> m_staging;
+			std::vector<u32> m_counts;
+			Buffer m_commandBuffer;
+			Buffer m_countBuffer;
+			IndirectBatchStateCallback m_stateCallback;
+			void* m_userData;
+			u32 m_maxCommands;
+			u32 m_maxBuckets;
+			u32 m_region;
+			u32 m_regionCount;
+			u32 m_lastBucket;
+			u32 m_drawCallCount;
+			bool m_useDrawCountBuffer;
+
+			void drawChunk(const IndirectBatchKey** current);
+
+		public:
+			IndirectBatch();
+			IndirectBatch(const IndirectBatch&) = delete;
+			~IndirectBatch();
+
+			IndirectBatch& operator=(const IndirectBatch&) = delete;
+
+			void create(const IndirectBatchDescription &desc);
+			void destroy();
+
+			// bucket indices stay valid until destroy
+			u32 getBucket(const IndirectBatchKey &key);
+			void add(u32 bucket, const DrawElementsIndirectCommand &command);
+			void add(const IndirectBatchKey &key, const DrawElementsIndirectCommand &command) { add(getBucket(key), command); }
+
+			// uploads and draws all commands added since the last submit
+			void submit();
+
+			// draws commands written by the gpu, the number of commands is read from drawCountBuffer at drawCountOffset
+			static void drawIndirectCount(PrimitveType mode, DataType indexType, const Buffer &commandBuffer, u32 commandOffset,
+				const Buffer &drawCountBuffer, u32 drawCountOffset, u32 maxDrawCount);
+
+			// multi draw calls issued by the last submit, more than one per bucket if a bucket was split between chunks
+			u32 getDrawCallCount() const { return m_drawCallCount; }
+		};
+	}
+}
\ No newline at end of file
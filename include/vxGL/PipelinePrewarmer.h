@@ -0,0 +1,75 @@
+#pragma once
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/Base.h>
+#include <vxLib/StringID.h>
+#include <vector>
+
+namespace vx
+{
+	namespace gl
+	{
+		class ProgramPipeline;
+
+		struct PipelinePrewarmTime
+		{
+			vx::StringID sid;
+			f32 milliseconds;
+		};
+
+		// Forces the driver to finish compiling pipelines by drawing with them once while rasterization is discarded.
+		// Graphics pipelines draw one triangle or patch with the given vertex array into the given framebuffer,
+		// compute pipelines dispatch zero work groups.
+		class PipelinePrewarmer
+		{
+			std::vector<PipelinePrewarmTime> m_times;
+			u32 m_vao;
+			u32 m_emptyVao;
+			u32 m_framebuffer;
+			s32 m_savedState[5];
+			bool m_savedDiscard;
+
+		public:
+			PipelinePrewarmer();
+			~PipelinePrewarmer();
+
+			// a vao of 0 uses an empty vertex array, a framebuffer of 0 the default framebuffer
+			void setState(u32 vao, u32 framebuffer);
+			void destroy();
+
+			// save and restore the gl state changed by warm
+			void begin();
+			void end();
+
+			// waits for the draw to finish and records how long it took
+			void warm(const vx::StringID &sid, const ProgramPipeline &pipeline);
+			void clear();
+
+			// the count pipelines that took longest, slowest first
+			void getSlowest(u32 count, std::vector<PipelinePrewarmTime>* times) const;
+			u32 getWarmedCount() const { return static_cast<u32>(m_times.size()); }
+		};
+	}
+}
\ No newline at end of file
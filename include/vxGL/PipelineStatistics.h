@@ -0,0 +1,109 @@
+#pragma once
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/Base.h>
+#include <vxLib/Container/sorted_vector.h>
+#include <deque>
+#include <vector>
+
+namespace vx
+{
+	namespace gl
+	{
+		class ProgramPipeline;
+
+		enum class PipelineStatistic : u8
+		{
+			VerticesSubmitted,
+			PrimitivesSubmitted,
+			VertexShaderInvocations,
+			TessControlShaderPatches,
+			TessEvaluationShaderInvocations,
+			GeometryShaderInvocations,
+			GeometryShaderPrimitivesEmitted,
+			FragmentShaderInvocations,
+			ComputeShaderInvocations,
+			ClippingInputPrimitives,
+			ClippingOutputPrimitives,
+			Count
+		};
+
+		struct PipelineStatisticsResult
+		{
+			u32 pipeline;
+			u32 samples; // number of resolved scopes
+			u64 values[static_cast<u32>(PipelineStatistic::Count)]; // summed over all samples, 0 for statistics not queried
+		};
+
+		// Wraps draws or passes in GL_ARB_pipeline_statistics_query queries and sums the results per program pipeline.
+		// Results are collected by update without waiting for the gpu, query objects are recycled.
+		class PipelineStatisticsPool
+		{
+			struct Scope
+			{
+				u32 pipeline;
+				u32 block;
+			};
+
+			std::vector<u32> m_queries; // blocks of one query per statistic
+			std::vector<u32> m_freeBlocks;
+			std::deque<Scope> m_pending;
+			vx::sorted_vector<u32, PipelineStatisticsResult> m_results;
+			u32 m_statistics[static_cast<u32>(PipelineStatistic::Count)];
+			u32 m_statisticCount;
+			u32 m_activeBlock;
+			u32 m_activePipeline;
+
+			u32 acquireBlock();
+			bool isAvailable(u32 block) const;
+
+		public:
+			PipelineStatisticsPool();
+			PipelineStatisticsPool(const PipelineStatisticsPool&) = delete;
+			~PipelineStatisticsPool();
+
+			PipelineStatisticsPool& operator=(const PipelineStatisticsPool&) = delete;
+
+			// statisticMask has bit 1 << PipelineStatistic set for every statistic to query,
+			// fails if the driver does not support GL_ARB_pipeline_statistics_query
+			bool create(u32 statisticMask);
+			void destroy();
+
+			// scopes can not be nested
+			void begin(const ProgramPipeline &pipeline);
+			void begin(u32 pipelineId);
+			void end();
+
+			// adds the results of finished scopes, never blocks. Returns the number of resolved scopes
+			u32 update();
+
+			const PipelineStatisticsResult* getResult(u32 pipelineId) const;
+			void getResults(std::vector<PipelineStatisticsResult>* results) const;
+			void clearResults();
+
+			u32 getPendingCount() const { return static_cast<u32>(m_pending.size()); }
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/TextureFormat.h>
+
+namespace vx
+{
+	namespace gl
+	{
+		enum class PixelConversionKernel : u8
+		{
+			None,
+			FloatToHalf,
+			Expand8, // rgb to rgba with opaque alpha
+			Swizzle8, // bgr(a) to rgb(a)
+			ExpandSwizzle8, // bgr to rgba with opaque alpha
+			FloatToSRGB8
+		};
+
+		struct PixelConversion
+		{
+			PixelConversionKernel kernel;
+			u8 srcChannels;
+			u8 dstChannels;
+			DataType dstDataType;
+			u32 srcPixelSize;
+			u32 dstPixelSize;
+		};
+
+		// Selects a cpu side conversion from client data to the transfer layout of target,
+		// so the driver does not convert on the calling thread.
+		// srcDataType and srcChannels describe the client data, bgr is set when red and blue are swapped.
+		// Returns false if the data can be uploaded as is or no conversion exists.
+		bool getPixelConversion(TextureFormat target, DataType srcDataType, u32 srcChannels, bool bgr, PixelConversion* conversion);
+
+		// dst must hold pixelCount * conversion.dstPixelSize bytes, uses SSSE3 and F16C when available
+		void convertPixels(const PixelConversion &conversion, const void* src, void* dst, u64 pixelCount);
+
+		u16 floatToHalf(f32 value);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/Base.h>
+#include <string>
+
+namespace vx
+{
+	namespace gl
+	{
+		class ShaderProgram;
+
+		// Stores program binaries on disk, one file per key.
+		// Keys combine the preprocessed source and the program type with the renderer and driver version,
+		// entries from another driver, cache version or a partially written file are ignored.
+		// Files are written to a temporary name and renamed, so several processes can share a directory.
+		class ProgramBinaryCache
+		{
+			std::string m_directory;
+			u64 m_contextHash;
+			bool m_enabled;
+
+			std::string getFileName(u64 key) const;
+
+		public:
+			ProgramBinaryCache();
+			~ProgramBinaryCache();
+
+			// needs a current context, disables itself if the driver has no binary formats
+			void initialize(const std::string &directory);
+
+			u64 getKey(const char* source, u64 sourceSize, ShaderProgramType type) const;
+
+			bool load(u64 key, ShaderProgram* program) const;
+			bool store(u64 key, const ShaderProgram &program) const;
+			void remove(u64 key) const;
+
+			bool isEnabled() const { return m_enabled; }
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/StringIdMap.h>
+
+namespace vx
+{
+	namespace gl
+	{
+		enum class ProgramResourceType : u8
+		{
+			Uniform,
+			Sampler,
+			Image,
+			UniformBlock,
+			ShaderStorageBlock
+		};
+
+		struct ProgramResource
+		{
+			s32 location; // -1 for blocks and uniforms inside a block
+			s32 offset; // byte offset inside the block, -1 for default block uniforms
+			s32 size; // array size of uniforms, data size in bytes of blocks
+			s32 binding; // texture unit, image unit or buffer binding, -1 for other uniforms
+			s32 blockIndex; // block the uniform belongs to, resource index of blocks
+			u32 glType; // data type of uniforms, 0 for blocks
+			ProgramResourceType type;
+		};
+
+		// Uniforms, samplers, images, uniform and shader storage blocks of a linked program, queried once after linking.
+		// Array uniforms are stored without the trailing [0].
+		class ProgramReflection
+		{
+			StringIdMap<ProgramResource> m_resources;
+
+			void addUniforms(u32 programId, char* name, s32 nameSize);
+			void addBlocks(u32 programId, u32 programInterface, ProgramResourceType type, char* name, s32 nameSize);
+
+		public:
+			ProgramReflection();
+			ProgramReflection(ProgramReflection &&rhs) noexcept;
+			~ProgramReflection();
+
+			ProgramReflection& operator=(ProgramReflection &&rhs) noexcept;
+
+			void create(u32 programId);
+			void clear();
+
+			const ProgramResource* find(const vx::StringID &sid) const { return m_resources.find(sid); }
+
+			// -1 if the program has no such uniform
+			s32 getUniformLocation(const vx::StringID &sid) const;
+			s32 getBinding(const vx::StringID &sid) const;
+
+			u32 getResourceCount() const { return m_resources.size(); }
+		};
+	}
+}
\ No newline at end of file
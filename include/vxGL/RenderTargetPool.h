@@ -0,0 +1,92 @@
+#pragma once
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/Texture.h>
+#include <vxGL/StringIdMap.h>
+#include <memory>
+#include <vector>
+
+namespace vx
+{
+	namespace gl
+	{
+		// Hands out recycled textures for the duration of a frame.
+		// Textures that have not been acquired for frameLifetime frames are destroyed in endFrame().
+		class RenderTargetPool
+		{
+			struct Entry
+			{
+				u32 bucket;
+				u32 lastUsedFrame;
+				u8 inUse;
+			};
+
+			// remembers its entry so release does not have to search for it
+			struct PooledTexture : public Texture
+			{
+				u32 entry;
+			};
+
+			struct DescriptionKey
+			{
+				static u64 hash(const TextureDescription &desc);
+				static bool isEqual(const TextureDescription &l, const TextureDescription &r);
+			};
+
+			// free entries of all textures with the same description, empty buckets are dropped in endFrame()
+			struct Bucket
+			{
+				std::vector<u32> freeEntries;
+			};
+
+			StringIdMap<Bucket, TextureDescription, DescriptionKey> m_buckets;
+			std::vector<Entry> m_entries;
+			std::vector<std::unique_ptr<PooledTexture>> m_textures;
+			u32 m_frame;
+			u32 m_frameLifetime;
+
+			void eraseEntry(u32 index);
+
+		public:
+			explicit RenderTargetPool(u32 frameLifetime = 8);
+			RenderTargetPool(const RenderTargetPool&) = delete;
+			~RenderTargetPool();
+
+			RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+
+			// returned texture stays valid until release() or endFrame()
+			const Texture* acquire(const TextureDescription &desc);
+			// allows the texture to be handed out again in the same frame
+			void release(const Texture* texture);
+
+			void endFrame();
+			void clear();
+
+			void setFrameLifetime(u32 frames) { m_frameLifetime = frames; }
+			u32 getTextureCount() const { return static_cast<u32>(m_entries.size()); }
+			u64 getMemoryUsage() const;
+		};
+	}
+}
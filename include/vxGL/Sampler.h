@@ -0,0 +1,82 @@
+#pragma once
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/Base.h>
+
+namespace vx
+{
+	namespace gl
+	{
+		enum class TextureCompareFunc : u32
+		{
+			Never = 0x0200,
+			Less = 0x0201,
+			Equal = 0x0202,
+			Lequal = 0x0203,
+			Greater = 0x0204,
+			Notequal = 0x0205,
+			Gequal = 0x0206,
+			Always = 0x0207
+		};
+
+		struct SamplerDescription
+		{
+			f32 lodBias;
+			TextureFilter minFilter;
+			TextureFilter magFilter;
+			TextureWrapMode wrapS;
+			TextureWrapMode wrapT;
+			TextureWrapMode wrapR;
+			u8 maxAnisotropy; // 0 or 1 disables anisotropic filtering
+			u8 compare; // compares against the reference value, only used by depth textures
+			TextureCompareFunc compareFunc;
+
+			SamplerDescription()
+				:lodBias(0.0f), minFilter(TextureFilter::LINEAR), magFilter(TextureFilter::LINEAR), wrapS(TextureWrapMode::REPEAT),
+				wrapT(TextureWrapMode::REPEAT), wrapR(TextureWrapMode::REPEAT), maxAnisotropy(0), compare(0), compareFunc(TextureCompareFunc::Lequal) {}
+		};
+
+		// clamps the anisotropy to 16 and resets state that has no effect, so equal sampling state compares equal
+		SamplerDescription getCanonicalSamplerDescription(const SamplerDescription &desc);
+
+		class Sampler : public Base < Sampler >
+		{
+		public:
+			Sampler();
+			Sampler(const Sampler&) = delete;
+			Sampler(Sampler &&rhs) noexcept;
+			~Sampler();
+
+			Sampler& operator=(const Sampler&) = delete;
+			Sampler& operator=(Sampler &&rhs) noexcept;
+
+			void create(const SamplerDescription &desc);
+			void destroy();
+
+			void bind(u32 unit) const;
+			void bindZero(u32 unit) const;
+		};
+	}
+}
@@ -0,0 +1,58 @@
+#pragma once
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/Sampler.h>
+#include <vxLib/Container/sorted_vector.h>
+
+namespace vx
+{
+	namespace gl
+	{
+		// Shares one sampler object between all textures that use the same sampling state.
+		class SamplerCache
+		{
+			vx::sorted_vector<u64, Sampler> m_samplers;
+
+			static u64 getKey(const SamplerDescription &desc);
+
+		public:
+			SamplerCache();
+			SamplerCache(const SamplerCache&) = delete;
+			~SamplerCache();
+
+			SamplerCache& operator=(const SamplerCache&) = delete;
+
+			// returns the id of a sampler with the given state, creates it on first use
+			u32 getSampler(const SamplerDescription &desc);
+
+			void clear();
+
+			u32 getSize() const { return static_cast<u32>(m_samplers.size()); }
+
+			static void bind(u32 unit, u32 sampler);
+			static void bind(u32 firstUnit, u32 count, const u32* samplers);
+		};
+	}
+}
@@ -0,0 +1,123 @@
+#pragma once
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/StringIdMap.h>
+#include <string>
+#include <vector>
+
+namespace vx
+{
+	namespace gl
+	{
+		enum class ShaderLoadPhase : u8
+		{
+			Hash, // reading and hashing the program and its includes for the cache keys
+			FileRead,
+			Preprocess,
+			BinaryCacheLoad,
+			Compile, // glCreateShaderProgramv
+			Link, // waiting for the link and validate status, overlaps with other programs if the driver compiles in parallel
+			BinaryCacheStore,
+			Pipeline,
+			Count
+		};
+
+		struct ShaderLoadTiming
+		{
+			std::string name;
+			f32 milliseconds[static_cast<u32>(ShaderLoadPhase::Count)];
+			f32 total;
+		};
+
+		// Records how long each phase of loading a program or pipeline takes.
+		class ShaderLoadProfiler
+		{
+			struct Event
+			{
+				u32 nameIndex;
+				ShaderLoadPhase phase;
+				u64 start; // microseconds since enable
+				u64 duration;
+			};
+
+			std::vector<Event> m_events;
+			std::vector<std::string> m_names;
+			StringIdMap<u32> m_nameIndices;
+			u64 m_origin;
+			bool m_enabled;
+
+			u32 getNameIndex(const std::string &name);
+
+		public:
+			ShaderLoadProfiler();
+			~ShaderLoadProfiler();
+
+			void enable(bool enable);
+			bool isEnabled() const { return m_enabled; }
+			void clear();
+
+			// microseconds since enable
+			u64 now() const;
+			void addEvent(const std::string &name, ShaderLoadPhase phase, u64 start, u64 end);
+
+			// timings per program or pipeline, slowest first
+			void getTimings(std::vector<ShaderLoadTiming>* timings) const;
+			f32 getPhaseTotal(ShaderLoadPhase phase) const;
+
+			// text table of getTimings
+			bool writeReport(const char* file) const;
+			// json for chrome://tracing
+			bool writeChromeTrace(const char* file) const;
+
+			static const char* getPhaseName(ShaderLoadPhase phase);
+		};
+
+		// times its own lifetime, does nothing if the profiler is disabled
+		class ShaderLoadScope
+		{
+			ShaderLoadProfiler* m_profiler;
+			const std::string &m_name;
+			u64 m_start;
+			ShaderLoadPhase m_phase;
+
+		public:
+			ShaderLoadScope(ShaderLoadProfiler* profiler, const std::string &name, ShaderLoadPhase phase)
+				:m_profiler(profiler->isEnabled() ? profiler : nullptr), m_name(name), m_start(0), m_phase(phase)
+			{
+				if (m_profiler)
+					m_start = m_profiler->now();
+			}
+
+			~ShaderLoadScope()
+			{
+				if (m_profiler)
+					m_profiler->addEvent(m_name, m_phase, m_start, m_profiler->now());
+			}
+
+			ShaderLoadScope(const ShaderLoadScope&) = delete;
+			ShaderLoadScope& operator=(const ShaderLoadScope&) = delete;
+		};
+	}
+}
\ No newline at end of file
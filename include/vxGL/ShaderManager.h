@@ -23,11 +23,21 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
-#include <vxGL/Base.h>
+#include <vxGL/FileWatcher.h>
+#include <vxGL/PipelinePrewarmer.h>
+#include <vxGL/ProgramBinaryCache.h>
+#include <vxGL/ShaderLoadProfiler.h>
+#include <vxGL/ShaderPermutation.h>
+#include <vxGL/ShaderPreprocessor.h>
+#include <vxGL/ShaderProgram.h>
+#include <vxGL/ShaderSourceCache.h>
+#include <vxGL/StringIdMap.h>
 #include <vxLib/Container/sorted_vector.h>
 #include <vxLib/StringID.h>
+#include <memory>
 #include <string>
-#include <vxLib/TextPreprocessor.h>
+#include <utility>
+#include <vector>
 
 namespace vx
 {
@@ -37,35 +47,126 @@ namespace vx
 	namespace gl
 	{
 		class ProgramPipeline;
-		class ShaderProgram;
-		struct ShaderParameter;
 
 		class ShaderManager
 		{
-			struct LoadUseProgramDescription;
-
-			vx::sorted_vector<vx::StringID, ProgramPipeline> m_programPipelines;
-			vx::sorted_vector<vx::StringID, ShaderProgram> m_shaderPrograms;
-			vx::TextPreprocessor m_textPreprocessor;
+			// define name, true to set it and false to remove it
+			typedef std::vector<std::pair<std::string, bool>> DefineOverrides;
+
+			struct PendingProgram
+			{
+				vx::StringID sid;
+				ShaderProgram program;
+				std::string file;
+				std::string source; // kept for the error file, empty if loaded from the binary cache
+				u64 binaryKey;
+
+				explicit PendingProgram(ShaderProgramType type) :sid(), program(type), file(), source(), binaryKey(0) {}
+			};
+
+			struct PendingPipeline
+			{
+				vx::StringID sid;
+				vx::StringID programs[6];
+				std::string files[6];
+				std::string name;
+				ProgramPipeline* target; // permutation variant to create, nullptr for a named pipeline
+				u8 stageMask;
+			};
+
+			struct ProgramSource
+			{
+				vx::StringID sid;
+				std::string file;
+				ShaderProgramType type;
+				DefineOverrides defines; // applied on top of the global defines
+				std::vector<u32> dependencies; // FileWatcher indices of the program file and all included files
+			};
+
+			struct IncludeFile
+			{
+				std::string file;
+				std::string key;
+				u32 watchIndex;
+			};
+
+			StringIdMap<ProgramPipeline> m_programPipelines;
+			StringIdMap<ShaderProgram> m_shaderPrograms;
+			std::vector<PendingProgram> m_pendingPrograms;
+			std::vector<PendingPipeline> m_pendingPipelines;
+			StringIdMap<ProgramSource> m_programSources;
+			std::vector<IncludeFile> m_includeFiles;
+			std::vector<std::unique_ptr<ShaderPermutationSet>> m_permutationSets;
+			vx::sorted_vector<vx::StringID, u32> m_permutationIndices;
+			FileWatcher m_fileWatcher;
+			ShaderPreprocessor m_preprocessor;
+			ProgramBinaryCache m_binaryCache;
+			ShaderSourceCache m_sourceCache;
+			PipelinePrewarmer m_prewarmer;
+			ShaderLoadProfiler m_profiler;
+			vx::sorted_vector<vx::StringID, u64> m_fileHashes; // hash of a file and everything it includes
+			std::vector<std::string> m_defines;
+			std::vector<std::string> m_parameters; // formatted as id=value
+			u64 m_stateHash;
+			u32 m_prewarmedCount;
 			std::string m_dataDir;
-
-			bool loadProgram(const FileHandle &programHandle, vx::gl::ShaderProgramType type, const std::string &programDir, const std::string &includeDir, vx::StackAllocator* scratchAllocator, std::string* error);
-			bool useProgram(vx::gl::ProgramPipeline &pipe, const FileHandle &handle);
-			bool loadUseProgram(const LoadUseProgramDescription &desc, vx::StackAllocator* scratchAllocator, std::string* error);
+			bool m_stateHashDirty;
+			bool m_hotReload;
+
+			bool submitProgram(const vx::StringID &sid, const std::string &file, vx::gl::ShaderProgramType type, const DefineOverrides &defines, std::string* error);
+			bool createProgram(PendingProgram* pending, std::string* error);
+			bool finishProgram(PendingProgram* pending, std::string* error);
+			void addDependencies(const std::string &file, std::vector<u32>* dependencies);
+			std::string resolveInclude(const std::string &name) const;
+			// fileText receives the contents of file if they had to be read for the hash
+			u64 getFileHash(const std::string &file, std::string* fileText);
+			u64 getStateHash();
+			void setParameter(const char* id, const char* value);
+			// returns the preprocessed source from the source cache or runs the preprocessor
+			bool preprocessProgram(const std::string &file, std::string* source);
+			bool useProgram(vx::gl::ProgramPipeline &pipe, const vx::StringID &sid, const std::string &file);
 
 			const vx::gl::ShaderProgram* getProgram(const vx::StringID &sid) const;
 
-			bool loadPipeline(const FileHandle &fileHandle, const char *id, const std::string &pipelineDir, const std::string &programDir, const std::string &includeDir, vx::StackAllocator* scratchAllocator, std::string* error);
+			bool beginLoadPipeline(const FileHandle &fileHandle, const char *id, const std::string &pipelineDir, const std::string &programDir, std::string* error);
+			bool pipelineExists(const vx::StringID &sid) const;
+			// reads a single pipeline file, stages are indexed by ShaderProgramType
+			bool readPipelineFile(const std::string &file, std::string (&stages)[6]);
+			// submits the programs of all used stages, programs built with overrides get the variant appended to their id
+			bool submitPipeline(const std::string (&stages)[6], const std::string &programDir, const std::string &variant, const DefineOverrides &defines,
+				PendingPipeline* pipeline, std::string* error);
+			// previous receives the overrides that restore the current state, can be nullptr
+			void applyDefines(const DefineOverrides &defines, DefineOverrides* previous);
+
+			ShaderPermutationSet* getPermutationSet(const vx::StringID &sid, u32* index) const;
+			bool submitPermutation(u32 permutationSet, u64 mask, std::string* error);
+			// finishes the programs queued from firstProgram on, the pipelines queued from firstPipeline on
+			// and the earlier programs those pipelines use, everything else stays pending
+			bool finishPending(u32 firstProgram, u32 firstPipeline, std::string* error);
 
 		public:
 			ShaderManager();
 			~ShaderManager();
 
-			void initialize(const std::string &dataDir);
+			// program binaries are cached in dataDir/shaders/cache/, requires a current context
+			void initialize(const std::string &dataDir, bool useBinaryCache = true);
 			void clear();
 
+			// loads all programs of the pipeline and creates it, waits for the driver to finish compiling.
+			// scratchAllocator is no longer used and can be nullptr
 			bool loadPipeline(const FileHandle &filehandle, const char *id, vx::StackAllocator* scratchAllocator, std::string* error);
 
+			// submits the programs of the pipeline without waiting for the compiler, the pipeline is created by finishLoading.
+			// submit all pipelines first so the driver can compile them in parallel
+			bool beginLoadPipeline(const FileHandle &filehandle, const char *id, std::string* error);
+			// submits all pipelines declared in the manifest, see ShaderManifest for the format
+			bool beginLoadManifest(const char* file, std::string* error);
+			bool loadManifest(const char* file, std::string* error);
+			// true if no submitted program is still compiling, never blocks
+			bool isLoadingComplete() const;
+			// collects the results of all submitted programs and creates their pipelines
+			bool finishLoading(std::string* error);
+
 			void addParameter(const char* id, s32 value);
 			void addParameter(const char* id, u32 value);
 			void addParameter(const char* id, f32 value);
@@ -75,8 +176,38 @@ namespace vx
 
 			void addIncludeFile(const char* file, const char* key);
 
+			// records the files every program is built from, must be enabled before loading pipelines
+			void enableHotReload(bool enable);
+			// recompiles programs whose source or include files changed and swaps them into the pipelines using them,
+			// programs that fail to compile keep their previous version. Returns the number of reloaded programs
+			u32 reloadChangedPrograms(std::string* error);
+
+			// declares the permutation keys of a pipeline, variants are requested by mask and loaded from the same pipeline file
+			bool declarePermutations(const FileHandle &fileHandle, const char* id, const ShaderPermutationKey* keys, u32 keyCount);
+			// returns the variant and compiles it on first use, nullptr if the mask is invalid or the variant failed to compile
+			const vx::gl::ProgramPipeline* getPermutation(const vx::StringID &sid, u64 mask, std::string* error);
+			// compiles all listed variants that were not requested yet in parallel
+			bool prewarmPermutations(const vx::StringID &sid, const u64* masks, u32 count, std::string* error);
+
 			const vx::gl::ProgramPipeline* getPipeline(const char* id) const;
 			const vx::gl::ProgramPipeline* getPipeline(const vx::StringID &sid) const;
+
+			// records the time of every loading phase per program and pipeline
+			void enableProfiling(bool enable);
+			const ShaderLoadProfiler& getProfiler() const { return m_profiler; }
+
+			// vao and framebuffer used by prewarmPipelines, see PipelinePrewarmer
+			void setPrewarmState(u32 vao, u32 framebuffer);
+			// draws once with every pipeline that was not warmed yet so the driver finishes compiling it before its first real draw.
+			// Stops when budgetMilliseconds are used up but warms at least one pipeline, call it every frame of a loading screen.
+			// Returns true once all loaded pipelines are warm
+			bool prewarmPipelines(f32 budgetMilliseconds);
+			void getSlowestPrewarms(u32 count, std::vector<PipelinePrewarmTime>* times) const;
+
+			// handles stay valid until clear, resolve them once after loading to skip the id lookup per frame
+			u32 getPipelineHandle(const char* id) const;
+			u32 getPipelineHandle(const vx::StringID &sid) const;
+			const vx::gl::ProgramPipeline* getPipelineByHandle(u32 handle) const;
 		};
 	}
 }
\ No newline at end of file
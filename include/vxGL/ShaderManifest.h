@@ -0,0 +1,89 @@
+#pragma once
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/Base.h>
+#include <string>
+#include <vector>
+
+namespace vx
+{
+	namespace gl
+	{
+		// points into the mapped manifest, not null terminated
+		struct ShaderManifestString
+		{
+			const char* ptr;
+			u32 size;
+
+			std::string str() const { return std::string(ptr, size); }
+		};
+
+		struct ShaderManifestPipeline
+		{
+			ShaderManifestString id;
+			ShaderManifestString stages[6]; // indexed by ShaderProgramType, empty for unused stages
+			u32 firstDefine;
+			u32 defineCount;
+		};
+
+		// Declares many pipelines in one file, one directive per line:
+		//
+		//	# comment
+		//	pipeline terrain
+		//		vertex terrain.vs
+		//		tess_control terrain.tcs
+		//		tess_eval terrain.tes
+		//		fragment terrain.fs
+		//		define USE_NORMAL_MAP
+		//
+		// The file is mapped and parsed in place, strings point into the mapping until close is called.
+		class ShaderManifest
+		{
+			void* m_file;
+			void* m_mapping;
+			const char* m_data;
+			u32 m_size;
+			std::vector<ShaderManifestPipeline> m_pipelines;
+			std::vector<ShaderManifestString> m_defines;
+
+			bool parse(std::string* error);
+
+		public:
+			ShaderManifest();
+			ShaderManifest(const ShaderManifest&) = delete;
+			~ShaderManifest();
+
+			ShaderManifest& operator=(const ShaderManifest&) = delete;
+
+			// maps the file and parses it, error receives the line of the first syntax error
+			bool open(const char* file, std::string* error);
+			void close();
+
+			u32 getPipelineCount() const { return static_cast<u32>(m_pipelines.size()); }
+			const ShaderManifestPipeline& getPipeline(u32 index) const { return m_pipelines[index]; }
+			const ShaderManifestString& getDefine(u32 index) const { return m_defines[index]; }
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/Base.h>
+#include <vxGL/StringIdMap.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace vx
+{
+	namespace gl
+	{
+		class ProgramPipeline;
+
+		// a bool key has a single define, an enum key one define per value
+		struct ShaderPermutationKey
+		{
+			const char* const* defines;
+			u32 defineCount;
+		};
+
+		// Variants of one pipeline selected by a bitmask. Keys are packed in declaration order,
+		// bool keys use one bit and enum keys as many bits as needed to store the value index.
+		// Pipeline pointers stay valid while the set exists.
+		class ShaderPermutationSet
+		{
+			struct Key
+			{
+				u32 firstDefine;
+				u32 defineCount;
+				u8 shift;
+				u8 bits;
+			};
+
+			std::vector<Key> m_keys;
+			std::vector<std::string> m_defines;
+			StringIdMap<std::unique_ptr<ProgramPipeline>, u64> m_pipelines;
+			std::string m_id;
+			std::string m_pipelineFile;
+
+		public:
+			ShaderPermutationSet();
+			~ShaderPermutationSet();
+
+			// fails if the keys need more than 64 bits
+			bool initialize(const char* id, const std::string &pipelineFile, const ShaderPermutationKey* keys, u32 keyCount);
+
+			// splits the permutation defines into the ones selected by mask and the rest,
+			// returns false if mask selects an enum value that does not exist
+			bool getDefines(u64 mask, std::vector<const char*>* enabled, std::vector<const char*>* disabled) const;
+
+			// returns nullptr if the variant was never requested
+			ProgramPipeline* find(u64 mask) const;
+			// adds an empty pipeline object for the variant
+			ProgramPipeline* insert(u64 mask);
+
+			const std::string& getId() const { return m_id; }
+			const std::string& getPipelineFile() const { return m_pipelineFile; }
+			u32 getVariantCount() const { return m_pipelines.size(); }
+			ProgramPipeline* getVariant(u32 index) const { return m_pipelines[index].get(); }
+		};
+	}
+}
\ No newline at end of file
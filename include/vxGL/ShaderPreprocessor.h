@@ -0,0 +1,111 @@
+#pragma once
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/Base.h>
+#include <string>
+#include <vector>
+
+namespace vx
+{
+	namespace gl
+	{
+		// Single pass shader preprocessor. Handles #if, #ifdef, #ifndef, #elif, #else, #endif, #include, #define, #undef
+		// and $name$ parameters, all other directives are passed through. #if expressions support integers, defined(),
+		// !, &&, || and comparisons, a define without a value counts as 1. Every file is included at most once.
+		// Skipped lines are kept as empty lines and every expanded include is wrapped in #line directives,
+		// includes get their own source string number, so compiler errors point to the right line of the right file.
+		class ShaderPreprocessor
+		{
+			struct Define
+			{
+				u64 hash;
+				const char* value;
+				u32 valueSize;
+			};
+
+			struct Parameter
+			{
+				u64 hash;
+				std::string value;
+			};
+
+			struct Include
+			{
+				u64 hash;
+				std::vector<char> text; // heap storage stays in place when the vector of includes grows
+				bool registered;
+			};
+
+			struct Condition
+			{
+				bool active;
+				bool parentActive;
+				bool taken;
+				bool hasElse;
+			};
+
+			std::vector<Define> m_defines; // global defines followed by the defines of the current file
+			std::vector<Parameter> m_parameters;
+			std::vector<Include> m_includes;
+			std::vector<u64> m_included;
+			std::vector<Condition> m_conditions;
+			std::vector<char> m_source;
+			std::vector<char> m_output;
+			std::string m_includeDir;
+			size_t m_outputSize;
+			u32 m_globalDefineCount;
+			u32 m_sourceStringCount;
+
+			bool process(const char* ptr, const char* end, u32 depth, u32 sourceString);
+			bool processDirective(const char* lineBegin, const char* ptr, const char* end, size_t conditionBase, u32 depth, u32 line, u32 sourceString);
+			bool processInclude(const char* ptr, const char* end, u32 depth, u32 line, u32 sourceString);
+			bool writeLine(const char* ptr, const char* end);
+			void write(const char* ptr, size_t size);
+			bool getInclude(const char* name, u32 size, const char** text, u32* textSize);
+			bool isActive() const;
+
+		public:
+			ShaderPreprocessor();
+			~ShaderPreprocessor();
+
+			// includes that were not registered with loadIncludeFile are loaded from this directory
+			void setIncludeDirectory(const std::string &directory);
+			// drops includes loaded from the include directory so they are read again
+			void clearIncludeCache();
+
+			void setDefine(const char* define);
+			void removeDefine(const char* define);
+			void setParameter(const char* name, const char* value);
+			bool loadIncludeFile(const char* file, const char* key);
+
+			// returns the preprocessed text, valid until the next call. nullptr on error
+			const char* preprocess(const char* text, u32 size, u32* outSize);
+			const char* preprocessFile(const char* file, u32* outSize);
+
+			// value and valueSize can be nullptr
+			bool findDefine(const char* name, u32 size, const char** value, u32* valueSize) const;
+		};
+	}
+}
\ No newline at end of file
@@ -24,6 +24,7 @@ SOFTWARE.
 */
 
 #include <vxGL/Base.h>
+#include <vxGL/ProgramReflection.h>
 #include <memory>
 
 namespace vx
@@ -34,6 +35,7 @@ namespace vx
 		{
 			typedef Base < ShaderProgram > MyBase;
 
+			ProgramReflection m_reflection;
 			ShaderProgramType m_type;
 
 			bool checkLinkStatus();
@@ -51,9 +53,26 @@ namespace vx
 			// on failure returns error log and logLength including null terminator
 			std::unique_ptr<char[]> create(const char **program, s32 &logLength);
 
+			// two phase creation, submit hands the source to the driver without querying the link status,
+			// so several programs can compile in parallel with GL_KHR_parallel_shader_compile
+			bool submit(const char **program);
+			// never blocks, always true if the driver does not compile in the background
+			bool isCompileComplete() const;
+			// waits for the driver and returns the error log like create on failure
+			std::unique_ptr<char[]> finish(s32 &logLength);
+			// creates a separable program from a blob returned by getBinary, fails if the driver rejects it
+			bool createFromBinary(u32 binaryFormat, const void* binary, s32 size);
+
+			// returns nullptr if the driver does not provide a binary
+			std::unique_ptr<u8[]> getBinary(u32* binaryFormat, s32* size) const;
+
 			void destroy();
 
 			ShaderProgramType getType() const { return m_type; }
+
+			// filled after a successful link
+			const ProgramReflection& getReflection() const { return m_reflection; }
+			s32 getUniformLocation(const vx::StringID &sid) const { return m_reflection.getUniformLocation(sid); }
 		};
 	}
 }
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/Base.h>
+#include <vxLib/Container/sorted_vector.h>
+#include <string>
+
+namespace vx
+{
+	namespace gl
+	{
+		// Preprocessed shader sources keyed by a hash of everything that affects the preprocessor output.
+		// Entries are kept in memory and, if a directory is set, on disk so the next start can skip preprocessing.
+		class ShaderSourceCache
+		{
+			vx::sorted_vector<u64, std::string> m_sources;
+			std::string m_directory;
+
+			std::string getFileName(u64 key) const;
+
+		public:
+			ShaderSourceCache();
+			~ShaderSourceCache();
+
+			// an empty directory keeps the cache in memory only
+			void initialize(const std::string &directory);
+			void clear();
+
+			bool find(u64 key, std::string* source);
+			void insert(u64 key, const std::string &source);
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,234 @@
+#pragma once
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/Base.h>
+#include <vxLib/StringID.h>
+#include <vector>
+
+namespace vx
+{
+	namespace gl
+	{
+		// hash and comparison of the keys a StringIdMap accepts, specialize for other key types
+		template<typename K>
+		struct StringIdMapKey;
+
+		template<>
+		struct StringIdMapKey<vx::StringID>
+		{
+			// string ids are already hashes, spread the upper bits into the low ones used for the slot
+			static u64 hash(const vx::StringID &key) { return key.value ^ (key.value >> 32); }
+			static bool isEqual(const vx::StringID &l, const vx::StringID &r) { return l.value == r.value; }
+		};
+
+		template<>
+		struct StringIdMapKey<u64>
+		{
+			static u64 hash(u64 key)
+			{
+				key ^= key >> 33;
+				key *= 0xff51afd7ed558ccdull;
+				key ^= key >> 33;
+				return key;
+			}
+
+			static bool isEqual(u64 l, u64 r) { return l == r; }
+		};
+
+		// Open addressing map from K to T with linear probing. Values are stored densely, the handle of a value is its index.
+		// Handles stay valid until clear, except that erase moves the last value into the erased handle.
+		template<typename T, typename K = vx::StringID, typename KeyTraits = StringIdMapKey<K>>
+		class StringIdMap
+		{
+			struct Slot
+			{
+				u64 hash;
+				u32 handle;
+			};
+
+			std::vector<Slot> m_slots;
+			std::vector<T> m_values;
+			std::vector<K> m_keys;
+
+			u64 findSlot(const K &key, u64 hash) const
+			{
+				u64 capacityMask = m_slots.size() - 1;
+				for (auto slot = hash & capacityMask; ; slot = (slot + 1) & capacityMask)
+				{
+					auto &it = m_slots[slot];
+					if (it.handle == s_invalidHandle || (it.hash == hash && KeyTraits::isEqual(m_keys[it.handle], key)))
+						return slot;
+				}
+			}
+
+			void insertSlot(u64 hash, u32 handle)
+			{
+				u64 capacityMask = m_slots.size() - 1;
+				auto slot = hash & capacityMask;
+				while (m_slots[slot].handle != s_invalidHandle)
+				{
+					slot = (slot + 1) & capacityMask;
+				}
+				m_slots[slot].hash = hash;
+				m_slots[slot].handle = handle;
+			}
+
+			void grow()
+			{
+				std::vector<Slot> slots(m_slots.empty() ? 16 : m_slots.size() * 2, Slot{ 0, s_invalidHandle });
+				m_slots.swap(slots);
+
+				for (auto &it : slots)
+				{
+					if (it.handle != s_invalidHandle)
+					{
+						insertSlot(it.hash, it.handle);
+					}
+				}
+			}
+
+			void removeSlot(u64 slot)
+			{
+				// backward shift deletion, moves later entries of the probe chain into the hole
+				u64 capacityMask = m_slots.size() - 1;
+				auto next = slot;
+				for (;;)
+				{
+					next = (next + 1) & capacityMask;
+					auto &it = m_slots[next];
+					if (it.handle == s_invalidHandle)
+						break;
+
+					// an entry can move back if its home slot is not in (slot, next]
+					auto home = it.hash & capacityMask;
+					if (((next - home) & capacityMask) >= ((next - slot) & capacityMask))
+					{
+						m_slots[slot] = it;
+						slot = next;
+					}
+				}
+
+				m_slots[slot].handle = s_invalidHandle;
+			}
+
+		public:
+			static const u32 s_invalidHandle = 0xffffffff;
+
+			typedef typename std::vector<T>::iterator iterator;
+			typedef typename std::vector<T>::const_iterator const_iterator;
+
+			StringIdMap() :m_slots(), m_values(), m_keys() {}
+
+			u32 getHandle(const K &key) const
+			{
+				if (m_slots.empty())
+					return s_invalidHandle;
+
+				return m_slots[findSlot(key, KeyTraits::hash(key))].handle;
+			}
+
+			T* find(const K &key)
+			{
+				auto handle = getHandle(key);
+				return (handle == s_invalidHandle) ? nullptr : &m_values[handle];
+			}
+
+			const T* find(const K &key) const
+			{
+				auto handle = getHandle(key);
+				return (handle == s_invalidHandle) ? nullptr : &m_values[handle];
+			}
+
+			// returns the handle of the new value, the key must not be in the map yet
+			u32 insert(const K &key, T &&value)
+			{
+				VX_ASSERT(getHandle(key) == s_invalidHandle);
+
+				// keep the load factor at or below one half
+				if ((m_values.size() + 1) * 2 > m_slots.size())
+				{
+					grow();
+				}
+
+				u32 handle = static_cast<u32>(m_values.size());
+				m_values.push_back(std::move(value));
+				m_keys.push_back(key);
+				insertSlot(KeyTraits::hash(key), handle);
+
+				return handle;
+			}
+
+			// removes the value, the last value takes over its handle
+			void erase(u32 handle)
+			{
+				VX_ASSERT(handle < m_values.size());
+
+				auto hash = KeyTraits::hash(m_keys[handle]);
+				removeSlot(findSlot(m_keys[handle], hash));
+
+				u32 last = static_cast<u32>(m_values.size() - 1);
+				if (handle != last)
+				{
+					auto &slot = m_slots[findSlot(m_keys[last], KeyTraits::hash(m_keys[last]))];
+					slot.handle = handle;
+
+					m_values[handle] = std::move(m_values[last]);
+					m_keys[handle] = std::move(m_keys[last]);
+				}
+
+				m_values.pop_back();
+				m_keys.pop_back();
+			}
+
+			void reserve(u32 count)
+			{
+				m_values.reserve(count);
+				m_keys.reserve(count);
+				while (m_slots.size() < count * 2)
+				{
+					grow();
+				}
+			}
+
+			void clear()
+			{
+				m_slots.clear();
+				m_values.clear();
+				m_keys.clear();
+			}
+
+			T& operator[](u32 handle) { return m_values[handle]; }
+			const T& operator[](u32 handle) const { return m_values[handle]; }
+
+			const K& getKey(u32 handle) const { return m_keys[handle]; }
+			u32 size() const { return static_cast<u32>(m_values.size()); }
+
+			iterator begin() { return m_values.begin(); }
+			iterator end() { return m_values.end(); }
+			const_iterator begin() const { return m_values.begin(); }
+			const_iterator end() const { return m_values.end(); }
+		};
+	}
+}
\ No newline at end of file
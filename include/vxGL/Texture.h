@@ -23,7 +23,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
-#include <vxGL/Base.h>
+#include <vxGL/TextureFormat.h>
 #include <vxLib/math/Vector.h>
 #include <vxLib/Container/bitset.h>
 
@@ -44,84 +44,6 @@ namespace vx
 			Texture_2D_MS_Array
 		};
 
-		enum class TextureFormat : u8
-		{
-			R8,
-			R8S,
-			R16,
-			R16S,
-			RG8,
-			RG8S,
-			RG16,
-			RG16S,
-			RGB4,
-			RGB5,
-			RGB8,
-			RGB8S,
-			RGB10,
-			RGB12,
-			RGB16S,
-			RGBA2,
-			RGBA4,
-			RGB5A1,
-			RGBA8,
-			RGBA8S,
-			RGB10A2,
-			RGB10A2UI,
-			RGBA12,
-			RGBA16,
-			SRGB8,
-			SRGBA8,
-			RGB_DXT1,
-			RGBA_DXT1,
-			RGBA_DXT3,
-			RGBA_DXT5,
-			SRGB_DXT1,
-			SRGBA_DXT1,
-			SRGBA_DXT3,
-			SRGBA_DXT5,
-			RGB_BC6UF,
-			RGB_BC6F,
-			RGBA_BC7,
-			SRGBA_BC7,
-			R16F,
-			RG16F,
-			RGB16F,
-			RGBA16F,
-			R32F,
-			RG32F,
-			RGB32F,
-			RGBA32F,
-			R8I,
-			R8UI,
-			R16I,
-			R16UI,
-			R32I,
-			R32UI,
-			RG8I,
-			RG8UI,
-			RG16I,
-			RG16UI,
-			RG32I,
-			RG32UI,
-			RGB8I,
-			RGB8UI,
-			RGB16I,
-			RGB16UI,
-			RGB32I,
-			RGB32UI,
-			RGBA8I,
-			RGBA8UI,
-			RGBA16I,
-			RGBA16UI,
-			RGBA32I,
-			RGBA32UI,
-			DEPTH16,
-			DEPTH24,
-			DEPTH32,
-			DEPTH32F
-		};
-
 		enum class TextureAccess : u32
 		{
 			Read = 0x88B8,
@@ -172,13 +94,17 @@ namespace vx
 			const void *p;
 		};
 
+		class TextureReadback;
+
 		class Texture : public Base < Texture >
 		{
 			u32 m_target;
 			u32 m_format;
 			u32 m_internalFormat;
 			vx::ushort3 m_size;
-			vx::bitset<4> m_formatData; // 1. bit sparse, 2. bit 1d, 3. bit 2d, 4. bit 3d
+			u16 m_miplevels; // samples for multisample textures
+			TextureFormat m_textureFormat;
+			vx::bitset<8> m_formatData; // 1. bit sparse, 2. bit 1d, 3. bit 2d, 4. bit 3d, 5. bit view
 			u8 m_compressed;
 
 			void allocate1D(const TextureDescription &desc);
@@ -198,6 +124,8 @@ namespace vx
 			Texture& operator=(Texture &&rhs) noexcept;
 
 			void create(const TextureDescription &desc);
+			// aliases the storage of source, returns false if type or format are not compatible with it
+			bool createView(const Texture &source, TextureType type, TextureFormat format, u32 minLevel, u32 numLevels, u32 minLayer, u32 numLayers);
 			void destroy();
 
 			void bind() const;
@@ -206,8 +134,14 @@ namespace vx
 			void commit(const TextureCommitDescription &desc) const;
 
 			void subImage(const TextureSubImageDescription &desc) const;
+			// uploads all regions with as few calls as possible, data of regions that cover consecutive layers
+			// of array or cubemap textures is merged into one call if it is contiguous in memory
+			void subImageBatch(const TextureSubImageDescription* descs, u32 count) const;
 			void subImageCompressed(const TextureCompressedSubImageDescription &desc) const;
+			// starts an asynchronous copy of one level and layer (or slice) into the pack buffer of result
+			bool readback(u32 level, u32 layer, TextureReadback* result) const;
 
+			// sampler objects from SamplerCache override these, prefer them when textures share sampling state
 			void setWrapMode1D(TextureWrapMode wrap_s) const;
 			void setWrapMode2D(TextureWrapMode wrap_s, TextureWrapMode wrap_t) const;
 			void setWrapMode3D(TextureWrapMode wrap_s, TextureWrapMode wrap_t, TextureWrapMode wrap_r) const;
@@ -224,12 +158,19 @@ namespace vx
 			u64 getImageHandle(u32 level, u8 layered, u32 layer) const;
 			const vx::ushort3& getSize() const;
 			u32 getTarget() const;
+			u32 getFormat() const;
+			u32 getInternalFormat() const;
+			TextureFormat getTextureFormat() const;
+			u16 getMipLevels() const;
+			// estimated size of the storage of all levels and layers
+			u64 getMemorySize() const;
 
 			bool isSparseTexture() const;
 			bool is1D() const;
 			bool is2D() const;
 			bool is3D() const;
 			bool isCompressed() const;
+			bool isView() const;
 		};
 	}
 }
\ No newline at end of file
@@ -0,0 +1,230 @@
+#pragma once
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/Base.h>
+#include <vxGL/flextGL.h>
+
+namespace vx
+{
+	namespace gl
+	{
+		enum class TextureFormat : u8
+		{
+			R8,
+			R8S,
+			R16,
+			R16S,
+			RG8,
+			RG8S,
+			RG16,
+			RG16S,
+			RGB4,
+			RGB5,
+			RGB8,
+			RGB8S,
+			RGB10,
+			RGB12,
+			RGB16S,
+			RGBA2,
+			RGBA4,
+			RGB5A1,
+			RGBA8,
+			RGBA8S,
+			RGB10A2,
+			RGB10A2UI,
+			RGBA12,
+			RGBA16,
+			SRGB8,
+			SRGBA8,
+			RGB_DXT1,
+			RGBA_DXT1,
+			RGBA_DXT3,
+			RGBA_DXT5,
+			SRGB_DXT1,
+			SRGBA_DXT1,
+			SRGBA_DXT3,
+			SRGBA_DXT5,
+			RGB_BC6UF,
+			RGB_BC6F,
+			RGBA_BC7,
+			SRGBA_BC7,
+			R16F,
+			RG16F,
+			RGB16F,
+			RGBA16F,
+			R32F,
+			RG32F,
+			RGB32F,
+			RGBA32F,
+			R8I,
+			R8UI,
+			R16I,
+			R16UI,
+			R32I,
+			R32UI,
+			RG8I,
+			RG8UI,
+			RG16I,
+			RG16UI,
+			RG32I,
+			RG32UI,
+			RGB8I,
+			RGB8UI,
+			RGB16I,
+			RGB16UI,
+			RGB32I,
+			RGB32UI,
+			RGBA8I,
+			RGBA8UI,
+			RGBA16I,
+			RGBA16UI,
+			RGBA32I,
+			RGBA32UI,
+			DEPTH16,
+			DEPTH24,
+			DEPTH32,
+			DEPTH32F
+		};
+
+		const u32 g_textureFormatCount = static_cast<u32>(TextureFormat::DEPTH32F) + 1;
+
+		struct TextureFormatTraits
+		{
+			u32 format; // pixel transfer format
+			u32 internalFormat;
+			DataType dataType; // default pixel transfer type
+			u8 bytesPerBlock; // bytes per texel for uncompressed formats
+			u8 blockWidth;
+			u8 blockHeight;
+			u8 channels;
+			u8 compressed;
+			u8 srgb;
+			u8 depth;
+			u8 integer;
+		};
+
+		namespace detail
+		{
+			struct TextureFormatTable
+			{
+				// format, internalFormat, dataType, bytesPerBlock, blockWidth, blockHeight, channels, compressed, srgb, depth, integer
+				static constexpr TextureFormatTraits s_traits[] =
+				{
+					{ GL_RED, GL_R8, DataType::Unsigned_Byte, 1, 1, 1, 1, 0, 0, 0, 0 }, // R8
+					{ GL_RED, GL_R8_SNORM, DataType::Byte, 1, 1, 1, 1, 0, 0, 0, 0 }, // R8S
+					{ GL_RED, GL_R16, DataType::Unsigned_Short, 2, 1, 1, 1, 0, 0, 0, 0 }, // R16
+					{ GL_RED, GL_R16_SNORM, DataType::Short, 2, 1, 1, 1, 0, 0, 0, 0 }, // R16S
+					{ GL_RG, GL_RG8, DataType::Unsigned_Byte, 2, 1, 1, 2, 0, 0, 0, 0 }, // RG8
+					{ GL_RG, GL_RG8_SNORM, DataType::Byte, 2, 1, 1, 2, 0, 0, 0, 0 }, // RG8S
+					{ GL_RG, GL_RG16, DataType::Unsigned_Short, 4, 1, 1, 2, 0, 0, 0, 0 }, // RG16
+					{ GL_RG, GL_RG16_SNORM, DataType::Short, 4, 1, 1, 2, 0, 0, 0, 0 }, // RG16S
+					{ GL_RGB, GL_RGB4, DataType::Unsigned_Byte, 3, 1, 1, 3, 0, 0, 0, 0 }, // RGB4
+					{ GL_RGB, GL_RGB5, DataType::Unsigned_Byte, 3, 1, 1, 3, 0, 0, 0, 0 }, // RGB5
+					{ GL_RGB, GL_RGB8, DataType::Unsigned_Byte, 3, 1, 1, 3, 0, 0, 0, 0 }, // RGB8
+					{ GL_RGB, GL_RGB8_SNORM, DataType::Byte, 3, 1, 1, 3, 0, 0, 0, 0 }, // RGB8S
+					{ GL_RGB, GL_RGB10, DataType::Unsigned_Short, 6, 1, 1, 3, 0, 0, 0, 0 }, // RGB10
+					{ GL_RGB, GL_RGB12, DataType::Unsigned_Short, 6, 1, 1, 3, 0, 0, 0, 0 }, // RGB12
+					{ GL_RGB, GL_RGB16_SNORM, DataType::Short, 6, 1, 1, 3, 0, 0, 0, 0 }, // RGB16S
+					{ GL_RGBA, GL_RGBA2, DataType::Unsigned_Byte, 4, 1, 1, 4, 0, 0, 0, 0 }, // RGBA2
+					{ GL_RGBA, GL_RGBA4, DataType::Unsigned_Byte, 4, 1, 1, 4, 0, 0, 0, 0 }, // RGBA4
+					{ GL_RGBA, GL_RGB5_A1, DataType::Unsigned_Byte, 4, 1, 1, 4, 0, 0, 0, 0 }, // RGB5A1
+					{ GL_RGBA, GL_RGBA8, DataType::Unsigned_Byte, 4, 1, 1, 4, 0, 0, 0, 0 }, // RGBA8
+					{ GL_RGBA, GL_RGBA8_SNORM, DataType::Byte, 4, 1, 1, 4, 0, 0, 0, 0 }, // RGBA8S
+					{ GL_RGBA, GL_RGB10_A2, DataType::Unsigned_Int_2_10_10_10_Rev, 4, 1, 1, 4, 0, 0, 0, 0 }, // RGB10A2
+					{ GL_RGBA_INTEGER, GL_RGB10_A2UI, DataType::Unsigned_Int_2_10_10_10_Rev, 4, 1, 1, 4, 0, 0, 0, 1 }, // RGB10A2UI
+					{ GL_RGBA, GL_RGBA12, DataType::Unsigned_Short, 8, 1, 1, 4, 0, 0, 0, 0 }, // RGBA12
+					{ GL_RGBA, GL_RGBA16, DataType::Unsigned_Short, 8, 1, 1, 4, 0, 0, 0, 0 }, // RGBA16
+					{ GL_RGB, GL_SRGB8, DataType::Unsigned_Byte, 3, 1, 1, 3, 0, 1, 0, 0 }, // SRGB8
+					{ GL_RGBA, GL_SRGB8_ALPHA8, DataType::Unsigned_Byte, 4, 1, 1, 4, 0, 1, 0, 0 }, // SRGBA8
+					{ GL_RGB, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, DataType::Unsigned_Byte, 8, 4, 4, 3, 1, 0, 0, 0 }, // RGB_DXT1
+					{ GL_RGBA, GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, DataType::Unsigned_Byte, 8, 4, 4, 4, 1, 0, 0, 0 }, // RGBA_DXT1
+					{ GL_RGBA, GL_COMPRESSED_RGBA_S3TC_DXT3_EXT, DataType::Unsigned_Byte, 16, 4, 4, 4, 1, 0, 0, 0 }, // RGBA_DXT3
+					{ GL_RGBA, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, DataType::Unsigned_Byte, 16, 4, 4, 4, 1, 0, 0, 0 }, // RGBA_DXT5
+					{ GL_RGB, GL_COMPRESSED_SRGB_S3TC_DXT1_EXT, DataType::Unsigned_Byte, 8, 4, 4, 3, 1, 1, 0, 0 }, // SRGB_DXT1
+					{ GL_RGBA, GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT, DataType::Unsigned_Byte, 8, 4, 4, 4, 1, 1, 0, 0 }, // SRGBA_DXT1
+					{ GL_RGBA, GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT, DataType::Unsigned_Byte, 16, 4, 4, 4, 1, 1, 0, 0 }, // SRGBA_DXT3
+					{ GL_RGBA, GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT, DataType::Unsigned_Byte, 16, 4, 4, 4, 1, 1, 0, 0 }, // SRGBA_DXT5
+					{ GL_RGB, GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT, DataType::Unsigned_Byte, 16, 4, 4, 3, 1, 0, 0, 0 }, // RGB_BC6UF
+					{ GL_RGB, GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT, DataType::Unsigned_Byte, 16, 4, 4, 3, 1, 0, 0, 0 }, // RGB_BC6F
+					{ GL_RGBA, GL_COMPRESSED_RGBA_BPTC_UNORM, DataType::Unsigned_Byte, 16, 4, 4, 4, 1, 0, 0, 0 }, // RGBA_BC7
+					{ GL_RGBA, GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM, DataType::Unsigned_Byte, 16, 4, 4, 4, 1, 1, 0, 0 }, // SRGBA_BC7
+					{ GL_RED, GL_R16F, DataType::Half_Float, 2, 1, 1, 1, 0, 0, 0, 0 }, // R16F
+					{ GL_RG, GL_RG16F, DataType::Half_Float, 4, 1, 1, 2, 0, 0, 0, 0 }, // RG16F
+					{ GL_RGB, GL_RGB16F, DataType::Half_Float, 6, 1, 1, 3, 0, 0, 0, 0 }, // RGB16F
+					{ GL_RGBA, GL_RGBA16F, DataType::Half_Float, 8, 1, 1, 4, 0, 0, 0, 0 }, // RGBA16F
+					{ GL_RED, GL_R32F, DataType::Float, 4, 1, 1, 1, 0, 0, 0, 0 }, // R32F
+					{ GL_RG, GL_RG32F, DataType::Float, 8, 1, 1, 2, 0, 0, 0, 0 }, // RG32F
+					{ GL_RGB, GL_RGB32F, DataType::Float, 12, 1, 1, 3, 0, 0, 0, 0 }, // RGB32F
+					{ GL_RGBA, GL_RGBA32F, DataType::Float, 16, 1, 1, 4, 0, 0, 0, 0 }, // RGBA32F
+					{ GL_RED_INTEGER, GL_R8I, DataType::Byte, 1, 1, 1, 1, 0, 0, 0, 1 }, // R8I
+					{ GL_RED_INTEGER, GL_R8UI, DataType::Unsigned_Byte, 1, 1, 1, 1, 0, 0, 0, 1 }, // R8UI
+					{ GL_RED_INTEGER, GL_R16I, DataType::Short, 2, 1, 1, 1, 0, 0, 0, 1 }, // R16I
+					{ GL_RED_INTEGER, GL_R16UI, DataType::Unsigned_Short, 2, 1, 1, 1, 0, 0, 0, 1 }, // R16UI
+					{ GL_RED_INTEGER, GL_R32I, DataType::Int, 4, 1, 1, 1, 0, 0, 0, 1 }, // R32I
+					{ GL_RED_INTEGER, GL_R32UI, DataType::Unsigned_Int, 4, 1, 1, 1, 0, 0, 0, 1 }, // R32UI
+					{ GL_RG_INTEGER, GL_RG8I, DataType::Byte, 2, 1, 1, 2, 0, 0, 0, 1 }, // RG8I
+					{ GL_RG_INTEGER, GL_RG8UI, DataType::Unsigned_Byte, 2, 1, 1, 2, 0, 0, 0, 1 }, // RG8UI
+					{ GL_RG_INTEGER, GL_RG16I, DataType::Short, 4, 1, 1, 2, 0, 0, 0, 1 }, // RG16I
+					{ GL_RG_INTEGER, GL_RG16UI, DataType::Unsigned_Short, 4, 1, 1, 2, 0, 0, 0, 1 }, // RG16UI
+					{ GL_RG_INTEGER, GL_RG32I, DataType::Int, 8, 1, 1, 2, 0, 0, 0, 1 }, // RG32I
+					{ GL_RG_INTEGER, GL_RG32UI, DataType::Unsigned_Int, 8, 1, 1, 2, 0, 0, 0, 1 }, // RG32UI
+					{ GL_RGB_INTEGER, GL_RGB8I, DataType::Byte, 3, 1, 1, 3, 0, 0, 0, 1 }, // RGB8I
+					{ GL_RGB_INTEGER, GL_RGB8UI, DataType::Unsigned_Byte, 3, 1, 1, 3, 0, 0, 0, 1 }, // RGB8UI
+					{ GL_RGB_INTEGER, GL_RGB16I, DataType::Short, 6, 1, 1, 3, 0, 0, 0, 1 }, // RGB16I
+					{ GL_RGB_INTEGER, GL_RGB16UI, DataType::Unsigned_Short, 6, 1, 1, 3, 0, 0, 0, 1 }, // RGB16UI
+					{ GL_RGB_INTEGER, GL_RGB32I, DataType::Int, 12, 1, 1, 3, 0, 0, 0, 1 }, // RGB32I
+					{ GL_RGB_INTEGER, GL_RGB32UI, DataType::Unsigned_Int, 12, 1, 1, 3, 0, 0, 0, 1 }, // RGB32UI
+					{ GL_RGBA_INTEGER, GL_RGBA8I, DataType::Byte, 4, 1, 1, 4, 0, 0, 0, 1 }, // RGBA8I
+					{ GL_RGBA_INTEGER, GL_RGBA8UI, DataType::Unsigned_Byte, 4, 1, 1, 4, 0, 0, 0, 1 }, // RGBA8UI
+					{ GL_RGBA_INTEGER, GL_RGBA16I, DataType::Short, 8, 1, 1, 4, 0, 0, 0, 1 }, // RGBA16I
+					{ GL_RGBA_INTEGER, GL_RGBA16UI, DataType::Unsigned_Short, 8, 1, 1, 4, 0, 0, 0, 1 }, // RGBA16UI
+					{ GL_RGBA_INTEGER, GL_RGBA32I, DataType::Int, 16, 1, 1, 4, 0, 0, 0, 1 }, // RGBA32I
+					{ GL_RGBA_INTEGER, GL_RGBA32UI, DataType::Unsigned_Int, 16, 1, 1, 4, 0, 0, 0, 1 }, // RGBA32UI
+					{ GL_DEPTH_COMPONENT, GL_DEPTH_COMPONENT16, DataType::Unsigned_Short, 2, 1, 1, 1, 0, 0, 1, 0 }, // DEPTH16
+					{ GL_DEPTH_COMPONENT, GL_DEPTH_COMPONENT24, DataType::Unsigned_Int, 4, 1, 1, 1, 0, 0, 1, 0 }, // DEPTH24
+					{ GL_DEPTH_COMPONENT, GL_DEPTH_COMPONENT32, DataType::Unsigned_Int, 4, 1, 1, 1, 0, 0, 1, 0 }, // DEPTH32
+					{ GL_DEPTH_COMPONENT, GL_DEPTH_COMPONENT32F, DataType::Float, 4, 1, 1, 1, 0, 0, 1, 0 } // DEPTH32F
+				};
+			};
+
+			static_assert(sizeof(TextureFormatTable::s_traits) / sizeof(TextureFormatTraits) == g_textureFormatCount, "TextureFormatTraits table does not match TextureFormat");
+		}
+
+		// usable in constant expressions
+		constexpr const TextureFormatTraits& getTextureFormatTraits(TextureFormat format)
+		{
+			return detail::TextureFormatTable::s_traits[static_cast<u32>(format)];
+		}
+
+		// size of one texel in client memory when transferred with dataType
+		u32 getPixelSize(TextureFormat format, DataType dataType);
+
+		// size of one row of texels or compressed blocks
+		u32 getTextureFormatPitch(TextureFormat format, u32 width);
+
+		// size of a single miplevel
+		u64 getTextureFormatSize(TextureFormat format, u32 width, u32 height, u32 depth);
+	}
+}
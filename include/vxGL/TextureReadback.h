@@ -0,0 +1,75 @@
+#pragma once
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/Buffer.h>
+#include <vxGL/TextureFormat.h>
+
+namespace vx
+{
+	namespace gl
+	{
+		class Texture;
+
+		// Copies one level and layer of a texture into a pixel pack buffer without stalling.
+		// The copy is fenced, poll isReady and read the data a few frames later.
+		class TextureReadback
+		{
+			Buffer m_buffer;
+			void* m_fence;
+			u64 m_capacity;
+			u64 m_size;
+			u32 m_width;
+			u32 m_height;
+			TextureFormat m_format;
+			DataType m_dataType;
+
+		public:
+			TextureReadback();
+			~TextureReadback();
+
+			TextureReadback(const TextureReadback&) = delete;
+			TextureReadback(TextureReadback &&rhs);
+
+			TextureReadback& operator=(const TextureReadback&) = delete;
+			TextureReadback& operator=(TextureReadback &&rhs);
+
+			// the pack buffer is reused for later requests of the same or smaller size
+			bool request(const Texture &texture, u32 level, u32 layer);
+			void release();
+
+			bool isPending() const;
+			bool isReady() const;
+
+			// copies the data into dst, waits for the gpu if the copy has not finished yet
+			bool read(void* dst, u64 dstSize);
+
+			u64 getSize() const { return m_size; }
+			u32 getWidth() const { return m_width; }
+			u32 getHeight() const { return m_height; }
+			TextureFormat getFormat() const { return m_format; }
+			DataType getDataType() const { return m_dataType; }
+		};
+	}
+}
\ No newline at end of file
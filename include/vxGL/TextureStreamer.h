@@ -0,0 +1,133 @@
+#pragma once
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/Texture.h>
+#include <vector>
+
+namespace vx
+{
+	namespace gl
+	{
+		struct TextureStreamerLevelData
+		{
+			const void* p;
+			DataType dataType;
+			u32 dataSize; // only used by compressed formats
+		};
+
+		// fills data with all layers of the miplevel, returns false if the data is not available yet
+		typedef bool(*TextureStreamerLoader)(u32 userId, u32 miplevel, TextureStreamerLevelData* data, void* userData);
+		// called whenever the finest resident level changes, minLod has to be applied when sampling the texture
+		typedef void(*TextureStreamerLodCallback)(u32 userId, f32 minLod, void* userData);
+
+		struct TextureStreamerDescription
+		{
+			u64 memoryBudget;
+			u32 maxUploadsPerUpdate;
+			TextureStreamerLoader loader;
+			TextureStreamerLodCallback lodCallback;
+			void* userData;
+			// clamps with GL_TEXTURE_BASE_LEVEL and GL_TEXTURE_MIN_LOD, must be off if the textures are used bindless
+			// because their state is immutable once a handle exists
+			u8 clampTextureState;
+
+			TextureStreamerDescription() :memoryBudget(0), maxUploadsPerUpdate(4), loader(nullptr), lodCallback(nullptr), userData(nullptr), clampTextureState(1) {}
+		};
+
+		// Streams the miplevels of sparse Texture_2D and Texture_2D_Array textures.
+		// Only the coarse tail is loaded when a texture is added, finer levels are committed and uploaded
+		// one at a time when they are requested and dropped again when the memory budget is exceeded.
+		// Shaders have to clamp sampling to the finest resident level with the value passed to the lod callback,
+		// for example stored next to the bindless handle. Texture state alone is not enough since a bound sampler
+		// object overrides GL_TEXTURE_MIN_LOD.
+		class TextureStreamer
+		{
+			static const u32 s_invalidIndex = 0xffffffff;
+
+			struct Entry
+			{
+				Texture texture;
+				u32 userId;
+				u32 lastRequestFrame;
+				u16 miplevels;
+				u16 tailLevel; // first level that is always resident
+				u16 residentLevel; // finest resident level
+				u16 requestedLevel;
+				u8 used;
+
+				Entry() :texture(), userId(0), lastRequestFrame(0), miplevels(0), tailLevel(0), residentLevel(0), requestedLevel(0), used(0) {}
+			};
+
+			std::vector<Entry> m_entries;
+			std::vector<u32> m_freeEntries;
+			std::vector<u32> m_candidates;
+			u64 m_memoryBudget;
+			u64 m_memoryUsage;
+			u32 m_maxUploadsPerUpdate;
+			u32 m_frame;
+			TextureStreamerLoader m_loader;
+			TextureStreamerLodCallback m_lodCallback;
+			void* m_userData;
+			u8 m_clampTextureState;
+
+			u64 getLevelSize(const Entry &entry, u32 level) const;
+			bool loadLevel(Entry &entry, u32 level);
+			void commitLevel(Entry &entry, u32 level, u8 commit);
+			void dropLevel(Entry &entry);
+			void clampLevel(const Entry &entry) const;
+			bool makeRoom(u64 size, u32 requester);
+
+		public:
+			TextureStreamer();
+			TextureStreamer(const TextureStreamer&) = delete;
+			~TextureStreamer();
+
+			TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+			void initialize(const TextureStreamerDescription &desc);
+			void shutdown();
+
+			// desc.sparse is forced on, tailLevels coarse levels are loaded immediately,
+			// returns s_invalidIndex if the driver cannot allocate the texture sparse or a tail level fails to load
+			u32 addTexture(const TextureDescription &desc, u32 tailLevels, u32 userId);
+			void removeTexture(u32 index);
+
+			// finest level the texture should have, reported by the caller or a feedback pass
+			void requestLevel(u32 index, u32 miplevel);
+			// converts the number of screen pixels covered by the texture along its larger axis into a level request
+			void requestScreenSize(u32 index, f32 pixels);
+
+			void update();
+
+			const Texture& getTexture(u32 index) const { return m_entries[index].texture; }
+			u32 getResidentLevel(u32 index) const { return m_entries[index].residentLevel; }
+			f32 getMinLod(u32 index) const { return (f32)m_entries[index].residentLevel; }
+			u64 getMemoryUsage() const { return m_memoryUsage; }
+			void setMemoryBudget(u64 budget) { m_memoryBudget = budget; }
+
+			static u32 getInvalidIndex() { return s_invalidIndex; }
+		};
+	}
+}
@@ -0,0 +1,147 @@
+#pragma once
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/Texture.h>
+#include <vxGL/Buffer.h>
+#include <vector>
+
+namespace vx
+{
+	namespace gl
+	{
+		struct VirtualTexturePage
+		{
+			u32 miplevel;
+			u32 layer;
+			vx::uint3 offset;
+			vx::uint3 size;
+		};
+
+		struct VirtualTexturePageData
+		{
+			const void* p;
+			DataType dataType;
+			u32 dataSize; // only used by compressed formats
+		};
+
+		// fills data with the texels of page, returns false if the page is not available yet
+		typedef bool(*VirtualTexturePageLoader)(const VirtualTexturePage &page, VirtualTexturePageData* data, void* userData);
+
+		struct VirtualTextureDescription
+		{
+			vx::ushort3 size; // z is the number of layers for Texture_2D_Array
+			u16 miplevels;
+			TextureType type;
+			TextureFormat format;
+			u32 maxCommittedPages;
+			u32 maxUploadsPerFrame;
+			u32 feedbackCapacity;
+			VirtualTexturePageLoader loader;
+			void* userData;
+
+			VirtualTextureDescription()
+				:size(), miplevels(1), type(TextureType::Texture_2D), format(TextureFormat::RGBA8), maxCommittedPages(0),
+				maxUploadsPerFrame(16), feedbackCapacity(4096), loader(nullptr), userData(nullptr) {}
+		};
+
+		// Manages the page commitment of a sparse texture.
+		// Shaders append requested pages to the feedback buffer, which is laid out as
+		// u32 count followed by feedbackCapacity page ids. A page id packs x in bits 0-9,
+		// y in bits 10-19, the miplevel in bits 20-23 and the layer in bits 24-31.
+		// Levels of the mip tail are committed on initialization and never evicted.
+		class VirtualTexture
+		{
+			struct MipInfo
+			{
+				u32 pagesX;
+				u32 pagesY;
+				u32 firstPage;
+			};
+
+			struct PageEntry
+			{
+				u32 lastUsedFrame;
+				u8 committed;
+			};
+
+			Texture m_texture;
+			Buffer m_feedbackBuffers[2];
+			void* m_fences[2];
+			std::vector<MipInfo> m_mips;
+			std::vector<PageEntry> m_pages;
+			std::vector<u32> m_committedPages;
+			std::vector<u32> m_requests;
+			vx::uint3 m_size;
+			vx::uint3 m_pageSize;
+			u32 m_miplevels;
+			u32 m_sparseLevels;
+			u32 m_layers;
+			u32 m_maxCommittedPages;
+			u32 m_maxUploadsPerFrame;
+			u32 m_feedbackCapacity;
+			u32 m_feedbackIndex;
+			u32 m_frame;
+			VirtualTexturePageLoader m_loader;
+			void* m_userData;
+
+			u32 getPageIndex(u32 miplevel, u32 layer, u32 x, u32 y) const;
+			void getPage(u32 pageId, VirtualTexturePage* page) const;
+			bool decodePageId(u32 pageId, u32* index) const;
+
+			void readFeedback(u32 bufferIndex);
+			void processRequests();
+			bool evictPage();
+			bool commitPage(u32 pageId, u8 commit);
+			bool loadPage(const VirtualTexturePage &page);
+			void commitMipTail();
+
+		public:
+			VirtualTexture();
+			VirtualTexture(const VirtualTexture&) = delete;
+			~VirtualTexture();
+
+			VirtualTexture& operator=(const VirtualTexture&) = delete;
+
+			bool initialize(const VirtualTextureDescription &desc);
+			void shutdown();
+
+			// binds the feedback buffer that is written by the current frame
+			void bindFeedbackBuffer(u32 bindingIndex) const;
+
+			// call once per frame after the feedback pass has been submitted
+			void update();
+
+			// requests a page from the cpu side, e.g. for prefetching
+			void requestPage(u32 miplevel, u32 layer, u32 x, u32 y);
+
+			static u32 makePageId(u32 miplevel, u32 layer, u32 x, u32 y);
+
+			const Texture& getTexture() const { return m_texture; }
+			const vx::uint3& getPageSize() const { return m_pageSize; }
+			u32 getCommittedPageCount() const { return static_cast<u32>(m_committedPages.size()); }
+			u32 getSparseLevels() const { return m_sparseLevels; }
+		};
+	}
+}
@@ -1,5 +1,8 @@
 /* WARNING: This file was automatically generated */
 /* Do not edit. */
+/* NOTE: GL_KHR_parallel_shader_compile was added by hand (constants, glMaxShaderCompilerThreadsKHR,
+   FLEXT_KHR_parallel_shader_compile and its add_extension entry). Add
+   "extension KHR_parallel_shader_compile optional" to the profile before regenerating. */
 
 #ifndef __gl_h_
 #define __gl_h_
@@ -1667,6 +1670,11 @@ typedef void (APIENTRY *GLDEBUGPROC)(GLenum source,GLenum type,GLuint id,GLenum
 
 #define GL_FILL_RECTANGLE_NV 0x933C
 
+/* GL_KHR_parallel_shader_compile */
+
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+
 /* --------------------------- FUNCTION PROTOTYPES --------------------------- */
 
 
@@ -4685,6 +4693,15 @@ GLAPI PFNGLSUBPIXELPRECISIONBIASNV_PROC *glpfSubpixelPrecisionBiasNV;
 
 
 
+/* GL_KHR_parallel_shader_compile */
+
+typedef void (APIENTRY PFNGLMAXSHADERCOMPILERTHREADSKHR_PROC (GLuint count));
+
+GLAPI PFNGLMAXSHADERCOMPILERTHREADSKHR_PROC *glpfMaxShaderCompilerThreadsKHR;
+
+#define glMaxShaderCompilerThreadsKHR glpfMaxShaderCompilerThreadsKHR
+
+
 /* --------------------------- CATEGORY DEFINES ------------------------------ */
 
 #define GL_VERSION_1_0
@@ -4724,6 +4741,7 @@ GLAPI PFNGLSUBPIXELPRECISIONBIASNV_PROC *glpfSubpixelPrecisionBiasNV;
 #define GL_NV_conservative_raster
 #define GL_NV_shader_atomic_fp16_vector
 #define GL_NV_fill_rectangle
+#define GL_KHR_parallel_shader_compile
 
 /* ---------------------- Flags for optional extensions ---------------------- */
 
@@ -4746,6 +4764,7 @@ extern int FLEXT_NV_shader_buffer_load;
 extern int FLEXT_NV_conservative_raster;
 extern int FLEXT_NV_shader_atomic_fp16_vector;
 extern int FLEXT_NV_fill_rectangle;
+extern int FLEXT_KHR_parallel_shader_compile;
 
 int flextInit(void);
 
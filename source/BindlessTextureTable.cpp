@@ -0,0 +1,343 @@
+/*
+The MIT License(MIT)
+
+Copyright(c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/BindlessTextureTable.h>
+#include <vxGL/Texture.h>
+#include <vxGL/gl.h>
+#include <algorithm>
+#include <memory>
+
+namespace vx
+{
+	namespace gl
+	{
+		BindlessTextureTable::BindlessTextureTable()
+			:m_entries(),
+			m_freeSlots(),
+			m_handleReferences(),
+			m_handleBuffer(),
+			m_fallbackHandle(0),
+			m_lruHead(s_invalidSlot),
+			m_lruTail(s_invalidSlot),
+			m_residentCount(0),
+			m_residentBudget(0),
+			m_frame(0),
+			m_dirtyBegin(s_invalidSlot),
+			m_dirtyEnd(0),
+			m_bindingIndex(0)
+		{
+		}
+
+		BindlessTextureTable::~BindlessTextureTable()
+		{
+			shutdown();
+		}
+
+		bool BindlessTextureTable::initialize(const BindlessTextureTableDescription &desc)
+		{
+			VX_ASSERT(desc.capacity != 0);
+
+			m_entries.resize(desc.capacity);
+			m_freeSlots.reserve(desc.capacity);
+			for (u32 i = 0; i < desc.capacity; ++i)
+			{
+				auto &entry = m_entries[i];
+				entry.handle = 0;
+				entry.textureId = 0;
+				entry.lastUsedFrame = 0;
+				entry.prev = s_invalidSlot;
+				entry.next = s_invalidSlot;
+				entry.resident = 0;
+				entry.used = 0;
+
+				m_freeSlots.push_back(desc.capacity - i - 1);
+			}
+
+			m_residentBudget = (desc.residentBudget == 0) ? desc.capacity : desc.residentBudget;
+			m_bindingIndex = desc.bindingIndex;
+
+			m_handleBuffer = BufferDescription::createImmutable(BufferType::Shader_Storage_Buffer, sizeof(u64) * desc.capacity, BufferStorageFlags::Dynamic_Storage, nullptr);
+			if (!m_handleBuffer.isValid())
+				return false;
+
+			u64 zero = 0;
+			glClearNamedBufferData(m_handleBuffer.getId(), GL_RG32UI, GL_RG_INTEGER, GL_UNSIGNED_INT, &zero);
+
+			return true;
+		}
+
+		void BindlessTextureTable::shutdown()
+		{
+			for (u32 i = 0; i < m_entries.size(); ++i)
+			{
+				if (m_entries[i].resident != 0)
+				{
+					releaseHandleReference(m_entries[i].handle);
+				}
+			}
+
+			if (m_fallbackHandle != 0)
+			{
+				releaseHandleReference(m_fallbackHandle);
+				m_fallbackHandle = 0;
+			}
+
+			VX_ASSERT(m_handleReferences.empty());
+
+			m_entries.clear();
+			m_freeSlots.clear();
+			m_handleReferences.clear();
+			m_handleBuffer.destroy();
+			m_lruHead = s_invalidSlot;
+			m_lruTail = s_invalidSlot;
+			m_residentCount = 0;
+			m_dirtyBegin = s_invalidSlot;
+			m_dirtyEnd = 0;
+		}
+
+		void BindlessTextureTable::setFallbackTexture(const Texture &texture)
+		{
+			// reference the new handle first, it can be the same as the old one
+			auto handle = texture.getTextureHandle();
+			addHandleReference(handle);
+
+			if (m_fallbackHandle != 0)
+			{
+				releaseHandleReference(m_fallbackHandle);
+			}
+
+			m_fallbackHandle = handle;
+
+			for (u32 i = 0; i < m_entries.size(); ++i)
+			{
+				if (m_entries[i].used != 0 && m_entries[i].resident == 0)
+				{
+					markDirty(i);
+				}
+			}
+		}
+
+		u32 BindlessTextureTable::addTexture(const Texture &texture)
+		{
+			if (m_freeSlots.empty())
+				return s_invalidSlot;
+
+			auto slot = m_freeSlots.back();
+			m_freeSlots.pop_back();
+
+			auto &entry = m_entries[slot];
+			entry.handle = texture.getTextureHandle();
+			entry.textureId = texture.getId();
+			entry.lastUsedFrame = m_frame;
+			entry.prev = s_invalidSlot;
+			entry.next = s_invalidSlot;
+			entry.resident = 0;
+			entry.used = 1;
+
+			markDirty(slot);
+
+			return slot;
+		}
+
+		void BindlessTextureTable::removeTexture(u32 slot)
+		{
+			VX_ASSERT(slot < m_entries.size());
+
+			auto &entry = m_entries[slot];
+			if (entry.used == 0)
+				return;
+
+			if (entry.resident != 0)
+			{
+				makeNonResident(slot);
+			}
+
+			entry.handle = 0;
+			entry.textureId = 0;
+			entry.used = 0;
+
+			m_freeSlots.push_back(slot);
+			markDirty(slot);
+		}
+
+		void BindlessTextureTable::requestResident(u32 slot)
+		{
+			VX_ASSERT(slot < m_entries.size());
+
+			auto &entry = m_entries[slot];
+			VX_ASSERT(entry.used != 0);
+
+			entry.lastUsedFrame = m_frame;
+
+			if (entry.resident == 0)
+			{
+				makeResident(slot);
+			}
+			else if (m_lruHead != slot)
+			{
+				lruRemove(slot);
+				lruPushFront(slot);
+			}
+		}
+
+		void BindlessTextureTable::update()
+		{
+			evict();
+
+			if (m_dirtyBegin <= m_dirtyEnd && m_dirtyBegin != s_invalidSlot)
+			{
+				auto count = m_dirtyEnd - m_dirtyBegin + 1;
+				auto staging = std::unique_ptr<u64[]>(new u64[count]);
+				for (u32 i = 0; i < count; ++i)
+				{
+					auto &entry = m_entries[m_dirtyBegin + i];
+					staging[i] = (entry.resident != 0) ? entry.handle : m_fallbackHandle;
+				}
+
+				m_handleBuffer.subData(sizeof(u64) * m_dirtyBegin, sizeof(u64) * count, staging.get());
+
+				m_dirtyBegin = s_invalidSlot;
+				m_dirtyEnd = 0;
+			}
+
+			++m_frame;
+		}
+
+		void BindlessTextureTable::bind() const
+		{
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, m_bindingIndex, m_handleBuffer.getId());
+		}
+
+		u64 BindlessTextureTable::getHandle(u32 slot) const
+		{
+			return m_entries[slot].handle;
+		}
+
+		bool BindlessTextureTable::isResident(u32 slot) const
+		{
+			return m_entries[slot].resident != 0;
+		}
+
+		void BindlessTextureTable::lruRemove(u32 slot)
+		{
+			auto &entry = m_entries[slot];
+
+			if (entry.prev != s_invalidSlot)
+				m_entries[entry.prev].next = entry.next;
+			else
+				m_lruHead = entry.next;
+
+			if (entry.next != s_invalidSlot)
+				m_entries[entry.next].prev = entry.prev;
+			else
+				m_lruTail = entry.prev;
+
+			entry.prev = s_invalidSlot;
+			entry.next = s_invalidSlot;
+		}
+
+		void BindlessTextureTable::lruPushFront(u32 slot)
+		{
+			auto &entry = m_entries[slot];
+			entry.prev = s_invalidSlot;
+			entry.next = m_lruHead;
+
+			if (m_lruHead != s_invalidSlot)
+				m_entries[m_lruHead].prev = slot;
+			else
+				m_lruTail = slot;
+
+			m_lruHead = slot;
+		}
+
+		void BindlessTextureTable::addHandleReference(u64 handle)
+		{
+			auto it = m_handleReferences.find(handle);
+			if (it == m_handleReferences.end())
+			{
+				glMakeTextureHandleResidentARB(handle);
+				m_handleReferences.insert(u64(handle), 1u);
+			}
+			else
+			{
+				++(*it);
+			}
+		}
+
+		void BindlessTextureTable::releaseHandleReference(u64 handle)
+		{
+			auto it = m_handleReferences.find(handle);
+			VX_ASSERT(it != m_handleReferences.end());
+			if (it == m_handleReferences.end())
+				return;
+
+			if (--(*it) == 0)
+			{
+				glMakeTextureHandleNonResidentARB(handle);
+				m_handleReferences.erase(it);
+			}
+		}
+
+		void BindlessTextureTable::makeResident(u32 slot)
+		{
+			auto &entry = m_entries[slot];
+			addHandleReference(entry.handle);
+			entry.resident = 1;
+			++m_residentCount;
+
+			lruPushFront(slot);
+			markDirty(slot);
+		}
+
+		void BindlessTextureTable::makeNonResident(u32 slot)
+		{
+			auto &entry = m_entries[slot];
+			releaseHandleReference(entry.handle);
+			entry.resident = 0;
+			--m_residentCount;
+
+			lruRemove(slot);
+			markDirty(slot);
+		}
+
+		void BindlessTextureTable::evict()
+		{
+			// handles used in the current frame might still be referenced by pending draws
+			while (m_residentCount > m_residentBudget && m_lruTail != s_invalidSlot)
+			{
+				auto slot = m_lruTail;
+				if (m_entries[slot].lastUsedFrame == m_frame)
+					break;
+
+				makeNonResident(slot);
+			}
+		}
+
+		void BindlessTextureTable::markDirty(u32 slot)
+		{
+			m_dirtyBegin = (m_dirtyBegin == s_invalidSlot) ? slot : std::min(m_dirtyBegin, slot);
+			m_dirtyEnd = std::max(m_dirtyEnd, slot);
+		}
+	}
+}
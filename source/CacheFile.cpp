@@ -0,0 +1,131 @@
+/*
+The MIT License(MIT)
+
+Copyright(c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/CacheFile.h>
+#include <Windows.h>
+#include <cstdio>
+#include <fstream>
+
+namespace CacheFileCpp
+{
+	struct FileHeader
+	{
+		u32 magic;
+		u32 version;
+		u64 key;
+		u64 checksum;
+		u64 size;
+	};
+}
+
+namespace vx
+{
+	namespace gl
+	{
+		u64 hashFnv1a(const void* data, u64 size, u64 value)
+		{
+			auto p = static_cast<const u8*>(data);
+			for (u64 i = 0; i < size; ++i)
+			{
+				value ^= p[i];
+				value *= 0x100000001b3ull;
+			}
+
+			return value;
+		}
+
+		bool writeCacheFile(const std::string &fileName, u32 magic, u32 version, u64 key, const void* data, u64 size)
+		{
+			CacheFileCpp::FileHeader header;
+			header.magic = magic;
+			header.version = version;
+			header.key = key;
+			header.checksum = hashFnv1a(data, size);
+			header.size = size;
+
+			char suffix[32];
+			snprintf(suffix, sizeof(suffix), ".%lu.tmp", static_cast<unsigned long>(GetCurrentProcessId()));
+			auto tmpFileName = fileName + suffix;
+
+			{
+				std::ofstream outFile(tmpFileName, std::ios::binary | std::ios::trunc);
+				if (!outFile.is_open())
+					return false;
+
+				outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+				outFile.write(static_cast<const char*>(data), size);
+				if (!outFile.good())
+				{
+					outFile.close();
+					DeleteFileA(tmpFileName.c_str());
+					return false;
+				}
+			}
+
+			// another process may have stored the same key in the meantime, both files are equivalent
+			if (!MoveFileExA(tmpFileName.c_str(), fileName.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+			{
+				DeleteFileA(tmpFileName.c_str());
+				return false;
+			}
+
+			return true;
+		}
+
+		bool readCacheFile(const std::string &fileName, u32 magic, u32 version, u64 key, std::string* data)
+		{
+			std::ifstream inFile(fileName, std::ios::binary | std::ios::ate);
+			if (!inFile.is_open())
+				return false;
+
+			auto fileSize = static_cast<s64>(inFile.tellg());
+			inFile.seekg(0, std::ios::beg);
+
+			CacheFileCpp::FileHeader header;
+			if (!inFile.read(reinterpret_cast<char*>(&header), sizeof(header)))
+				return false;
+
+			if (header.magic != magic ||
+				header.version != version ||
+				header.key != key)
+				return false;
+
+			// the size is checked against the file before it is trusted for the allocation
+			if (fileSize < (s64)sizeof(header) || header.size != (u64)(fileSize - (s64)sizeof(header)))
+				return false;
+
+			std::string result;
+			result.resize(header.size);
+			if (header.size != 0 && !inFile.read(&result[0], header.size))
+				return false;
+
+			if (hashFnv1a(result.data(), result.size()) != header.checksum)
+				return false;
+
+			data->swap(result);
+
+			return true;
+		}
+	}
+}
@@ -0,0 +1,99 @@
+/*
+The MIT License(MIT)
+
+Copyright(c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/FileWatcher.h>
+#include <Windows.h>
+
+namespace FileWatcherCpp
+{
+	u64 getWriteTime(const char* path)
+	{
+		WIN32_FILE_ATTRIBUTE_DATA data;
+		if (!GetFileAttributesExA(path, GetFileExInfoStandard, &data))
+			return 0;
+
+		return ((u64)data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime;
+	}
+}
+
+namespace vx
+{
+	namespace gl
+	{
+		FileWatcher::FileWatcher()
+			:m_entries(),
+			m_indices()
+		{
+		}
+
+		FileWatcher::~FileWatcher()
+		{
+		}
+
+		u32 FileWatcher::addFile(const std::string &path)
+		{
+			auto sid = vx::make_sid(path.c_str());
+			auto it = m_indices.find(sid);
+			if (it != m_indices.end())
+				return *it;
+
+			u32 index = static_cast<u32>(m_entries.size());
+
+			Entry entry;
+			entry.path = path;
+			entry.writeTime = FileWatcherCpp::getWriteTime(path.c_str());
+			m_entries.push_back(std::move(entry));
+
+			m_indices.insert(std::move(sid), std::move(index));
+
+			return index;
+		}
+
+		void FileWatcher::clear()
+		{
+			m_entries.clear();
+			m_indices.clear();
+		}
+
+		u32 FileWatcher::poll(std::vector<u32>* changed)
+		{
+			u32 count = 0;
+			u32 index = 0;
+			for (auto &it : m_entries)
+			{
+				// editors may briefly remove a file while saving, wait until it exists again
+				auto writeTime = FileWatcherCpp::getWriteTime(it.path.c_str());
+				if (writeTime != 0 && writeTime != it.writeTime)
+				{
+					it.writeTime = writeTime;
+					changed->push_back(index);
+					++count;
+				}
+				++index;
+			}
+
+			return count;
+		}
+	}
+}
\ No newline at end of file
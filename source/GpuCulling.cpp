@@ -0,0 +1,212 @@
+/*
+The MIT License(MIT)
+
+Copyright(c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/GpuCulling.h>
+#include <vxGL/IndirectBatch.h>
+#include <vxGL/StateManager.h>
+#include <vxGL/gl.h>
+#include <vxLib/StringID.h>
+#include <cstdio>
+
+namespace GpuCullingCpp
+{
+	const u32 g_groupSize = 64;
+
+	const char* g_cullingSource =
+		"#version 450\n"
+		"layout(local_size_x = 64) in;\n"
+		"struct Instance { vec4 sphere; uint count; uint firstIndex; int baseVertex; uint padding; };\n"
+		"struct Command { uint count; uint instanceCount; uint firstIndex; int baseVertex; uint baseInstance; };\n"
+		"layout(std430, binding = 0) readonly buffer InstanceBuffer { Instance u_instances[]; };\n"
+		"layout(std430, binding = 1) writeonly buffer CommandBuffer { Command u_commands[]; };\n"
+		"layout(std430, binding = 2) buffer CountBuffer { uint u_count; };\n"
+		"layout(binding = 0) uniform sampler2D u_hiZ;\n"
+		"uniform vec4 u_planes[6];\n"
+		"uniform mat4 u_viewProjection;\n"
+		"uniform uint u_instanceCount;\n"
+		"uniform int u_hiZLevels;\n"
+		"bool isOccluded(vec4 sphere)\n"
+		"{\n"
+		"	vec3 minUv = vec3(1.0);\n"
+		"	vec3 maxUv = vec3(0.0);\n"
+		"	for (int i = 0; i < 8; ++i)\n"
+		"	{\n"
+		"		vec3 corner = sphere.xyz + sphere.w * vec3((i & 1) != 0 ? 1.0 : -1.0, (i & 2) != 0 ? 1.0 : -1.0, (i & 4) != 0 ? 1.0 : -1.0);\n"
+		"		vec4 clip = u_viewProjection * vec4(corner, 1.0);\n"
+		"		if (clip.w <= 0.0)\n"
+		"			return false;\n"
+		"		vec3 uv = clip.xyz / clip.w * 0.5 + 0.5;\n"
+		"		minUv = min(minUv, uv);\n"
+		"		maxUv = max(maxUv, uv);\n"
+		"	}\n"
+		"	minUv = clamp(minUv, 0.0, 1.0);\n"
+		"	maxUv = clamp(maxUv, 0.0, 1.0);\n"
+		"	vec2 size = (maxUv.xy - minUv.xy) * vec2(textureSize(u_hiZ, 0));\n"
+		"	int level = clamp(int(ceil(log2(max(max(size.x, size.y), 1.0)))), 0, u_hiZLevels - 1);\n"
+		"	ivec2 levelSize = textureSize(u_hiZ, level);\n"
+		"	ivec2 minTexel = clamp(ivec2(minUv.xy * vec2(levelSize)), ivec2(0), levelSize - 1);\n"
+		"	ivec2 maxTexel = clamp(ivec2(maxUv.xy * vec2(levelSize)), ivec2(0), levelSize - 1);\n"
+		"	float depth = max(max(texelFetch(u_hiZ, minTexel, level).r, texelFetch(u_hiZ, ivec2(maxTexel.x, minTexel.y), level).r),\n"
+		"		max(texelFetch(u_hiZ, ivec2(minTexel.x, maxTexel.y), level).r, texelFetch(u_hiZ, maxTexel, level).r));\n"
+		"	return minUv.z > depth;\n"
+		"}\n"
+		"void main()\n"
+		"{\n"
+		"	uint index = gl_GlobalInvocationID.x;\n"
+		"	if (index >= u_instanceCount)\n"
+		"		return;\n"
+		"	Instance instance = u_instances[index];\n"
+		"	for (int i = 0; i < 6; ++i)\n"
+		"	{\n"
+		"		if (dot(u_planes[i].xyz, instance.sphere.xyz) + u_planes[i].w < -instance.sphere.w)\n"
+		"			return;\n"
+		"	}\n"
+		"	if (u_hiZLevels > 0 && isOccluded(instance.sphere))\n"
+		"		return;\n"
+		"	uint slot = atomicAdd(u_count, 1u);\n"
+		"	u_commands[slot] = Command(instance.count, 1u, instance.firstIndex, instance.baseVertex, index);\n"
+		"}\n";
+}
+
+namespace vx
+{
+	namespace gl
+	{
+		GpuCulling::GpuCulling()
+			:m_program(ShaderProgramType::COMPUTE),
+			m_pipeline(),
+			m_instanceBuffer(),
+			m_commandBuffer(),
+			m_countBuffer(),
+			m_planesLocation(-1),
+			m_viewProjectionLocation(-1),
+			m_instanceCountLocation(-1),
+			m_hiZLevelsLocation(-1),
+			m_maxInstances(0),
+			m_instanceCount(0)
+		{
+		}
+
+		GpuCulling::~GpuCulling()
+		{
+			destroy();
+		}
+
+		bool GpuCulling::create(u32 maxInstances)
+		{
+			VX_ASSERT(maxInstances != 0);
+
+			destroy();
+
+			s32 logLength = 0;
+			auto log = m_program.create(&GpuCullingCpp::g_cullingSource, logLength);
+			if (log)
+			{
+				printf("GpuCulling: error compiling culling program\n%s\n", log.get());
+				m_program.destroy();
+				return false;
+			}
+
+			m_pipeline.create();
+			m_pipeline.useProgram(m_program);
+
+			m_planesLocation = m_program.getUniformLocation(vx::make_sid("u_planes"));
+			m_viewProjectionLocation = m_program.getUniformLocation(vx::make_sid("u_viewProjection"));
+			m_instanceCountLocation = m_program.getUniformLocation(vx::make_sid("u_instanceCount"));
+			m_hiZLevelsLocation = m_program.getUniformLocation(vx::make_sid("u_hiZLevels"));
+
+			m_instanceBuffer = BufferDescription::createImmutable(BufferType::Shader_Storage_Buffer, sizeof(GpuCullingInstance) * maxInstances, BufferStorageFlags::Dynamic_Storage, nullptr);
+			m_commandBuffer = BufferDescription::createImmutable(BufferType::Draw_Indirect_Buffer, sizeof(DrawElementsIndirectCommand) * maxInstances, BufferStorageFlags::None, nullptr);
+			m_countBuffer = BufferDescription::createImmutable(BufferType::Parameter_Buffer, sizeof(u32), BufferStorageFlags::None, nullptr);
+
+			m_maxInstances = maxInstances;
+			m_instanceCount = 0;
+
+			return true;
+		}
+
+		void GpuCulling::destroy()
+		{
+			m_pipeline.destroy();
+			m_program.destroy();
+			m_instanceBuffer.destroy();
+			m_commandBuffer.destroy();
+			m_countBuffer.destroy();
+			m_maxInstances = 0;
+			m_instanceCount = 0;
+		}
+
+		void GpuCulling::setInstances(const GpuCullingInstance* instances, u32 offset, u32 count)
+		{
+			VX_ASSERT(offset + count <= m_maxInstances);
+
+			m_instanceBuffer.subData(sizeof(GpuCullingInstance) * offset, sizeof(GpuCullingInstance) * count, instances);
+		}
+
+		void GpuCulling::setInstanceCount(u32 count)
+		{
+			VX_ASSERT(count <= m_maxInstances);
+
+			m_instanceCount = count;
+		}
+
+		void GpuCulling::cull(const GpuCullingView &view)
+		{
+			u32 zero = 0;
+			glClearNamedBufferSubData(m_countBuffer.getId(), GL_R32UI, 0, sizeof(u32), GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+
+			if (m_instanceCount == 0)
+				return;
+
+			auto programId = m_program.getId();
+			glProgramUniform4fv(programId, m_planesLocation, 6, &view.planes[0].x);
+			glProgramUniformMatrix4fv(programId, m_viewProjectionLocation, 1, GL_FALSE, view.viewProjection);
+			glProgramUniform1ui(programId, m_instanceCountLocation, m_instanceCount);
+			glProgramUniform1i(programId, m_hiZLevelsLocation, (view.hiZTexture != 0) ? view.hiZLevels : 0);
+
+			if (view.hiZTexture != 0)
+			{
+				glBindTextureUnit(0, view.hiZTexture);
+			}
+
+			// unlike glBindBufferBase this leaves the generic binding tracked by StateManager untouched
+			const u32 buffers[] = { m_instanceBuffer.getId(), m_commandBuffer.getId(), m_countBuffer.getId() };
+			glBindBuffersBase(GL_SHADER_STORAGE_BUFFER, 0, 3, buffers);
+
+			StateManager::bindPipeline(m_pipeline);
+			glDispatchCompute((m_instanceCount + GpuCullingCpp::g_groupSize - 1) / GpuCullingCpp::g_groupSize, 1, 1);
+
+			// the commands and the count are read by the following indirect draw
+			glMemoryBarrier(GL_COMMAND_BARRIER_BIT);
+		}
+
+		void GpuCulling::draw(PrimitveType mode, DataType indexType) const
+		{
+			if (m_instanceCount == 0)
+				return;
+
+			IndirectBatch::drawIndirectCount(mode, indexType, m_commandBuffer, 0, m_countBuffer, 0, m_instanceCount);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,320 @@
+/*
+The MIT License(MIT)
+
+Copyright(c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/ImageCompare.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <emmintrin.h>
+
+namespace ImageCompareCpp
+{
+	struct ErrorSum
+	{
+		f64 squared;
+		f32 max;
+	};
+
+	f32 halfToFloat(u16 h)
+	{
+		u32 sign = (u32)(h & 0x8000) << 16;
+		u32 exponent = (h >> 10) & 0x1f;
+		u32 mantissa = h & 0x3ff;
+
+		u32 bits;
+		if (exponent == 0x1f)
+		{
+			bits = sign | 0x7f800000 | (mantissa << 13);
+		}
+		else if (exponent != 0)
+		{
+			bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+		}
+		else
+		{
+			f32 value = mantissa * (1.0f / 16777216.0f);
+			return sign ? -value : value;
+		}
+
+		f32 value;
+		memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	ErrorSum compareU8(const u8* a, const u8* b, u64 count)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		__m128i maxDiff = zero;
+		__m128i sum64 = zero;
+
+		u64 i = 0;
+		while (i + 16 <= count)
+		{
+			// each 32 bit lane gains at most 4 * 255^2 per block, flush to 64 bit every 4096 blocks
+			u64 end = std::min<u64>(count & ~15ull, i + 16 * 4096);
+			__m128i sum32 = zero;
+			for (; i < end; i += 16)
+			{
+				__m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+				__m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+				__m128i diff = _mm_or_si128(_mm_subs_epu8(va, vb), _mm_subs_epu8(vb, va));
+				maxDiff = _mm_max_epu8(maxDiff, diff);
+
+				__m128i lo = _mm_unpacklo_epi8(diff, zero);
+				__m128i hi = _mm_unpackhi_epi8(diff, zero);
+				sum32 = _mm_add_epi32(sum32, _mm_add_epi32(_mm_madd_epi16(lo, lo), _mm_madd_epi16(hi, hi)));
+			}
+
+			sum64 = _mm_add_epi64(sum64, _mm_add_epi64(_mm_unpacklo_epi32(sum32, zero), _mm_unpackhi_epi32(sum32, zero)));
+		}
+
+		alignas(16) u64 sums[2];
+		alignas(16) u8 maxima[16];
+		_mm_store_si128(reinterpret_cast<__m128i*>(sums), sum64);
+		_mm_store_si128(reinterpret_cast<__m128i*>(maxima), maxDiff);
+
+		u64 squared = sums[0] + sums[1];
+		u32 maxValue = *std::max_element(maxima, maxima + 16);
+		for (; i < count; ++i)
+		{
+			u32 diff = (a[i] > b[i]) ? a[i] - b[i] : b[i] - a[i];
+			squared += diff * diff;
+			maxValue = std::max(maxValue, diff);
+		}
+
+		const f64 scale = 1.0 / 255.0;
+		return{ squared * scale * scale, static_cast<f32>(maxValue * scale) };
+	}
+
+	ErrorSum compareU16(const u16* a, const u16* b, u64 count)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i signBit = _mm_set1_epi16(-0x8000);
+		__m128i maxDiff = zero;
+		__m128i sum64 = zero;
+
+		u64 i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			__m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+			__m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+			__m128i diff = _mm_or_si128(_mm_subs_epu16(va, vb), _mm_subs_epu16(vb, va));
+
+			// sse2 only has a signed 16 bit max, flip the sign bit around it
+			maxDiff = _mm_xor_si128(_mm_max_epi16(_mm_xor_si128(maxDiff, signBit), _mm_xor_si128(diff, signBit)), signBit);
+
+			// squares of 16 bit values need 32 bits each, widen before multiplying
+			__m128i lo = _mm_unpacklo_epi16(diff, zero);
+			__m128i hi = _mm_unpackhi_epi16(diff, zero);
+			__m128i sqLo = _mm_mul_epu32(lo, lo);
+			__m128i sqHi = _mm_mul_epu32(hi, hi);
+			__m128i sqLoOdd = _mm_mul_epu32(_mm_srli_epi64(lo, 32), _mm_srli_epi64(lo, 32));
+			__m128i sqHiOdd = _mm_mul_epu32(_mm_srli_epi64(hi, 32), _mm_srli_epi64(hi, 32));
+			sum64 = _mm_add_epi64(sum64, _mm_add_epi64(_mm_add_epi64(sqLo, sqHi), _mm_add_epi64(sqLoOdd, sqHiOdd)));
+		}
+
+		alignas(16) u64 sums[2];
+		alignas(16) u16 maxima[8];
+		_mm_store_si128(reinterpret_cast<__m128i*>(sums), sum64);
+		_mm_store_si128(reinterpret_cast<__m128i*>(maxima), maxDiff);
+
+		u64 squared = sums[0] + sums[1];
+		u32 maxValue = *std::max_element(maxima, maxima + 8);
+		for (; i < count; ++i)
+		{
+			u64 diff = (a[i] > b[i]) ? a[i] - b[i] : b[i] - a[i];
+			squared += diff * diff;
+			maxValue = std::max(maxValue, static_cast<u32>(diff));
+		}
+
+		const f64 scale = 1.0 / 65535.0;
+		return{ squared * scale * scale, static_cast<f32>(maxValue * scale) };
+	}
+
+	ErrorSum compareF32(const f32* a, const f32* b, u64 count)
+	{
+		const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+		__m128 maxDiff = _mm_setzero_ps();
+		__m128d sum = _mm_setzero_pd();
+
+		u64 i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 diff = _mm_and_ps(_mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)), absMask);
+			maxDiff = _mm_max_ps(maxDiff, diff);
+
+			__m128d lo = _mm_cvtps_pd(diff);
+			__m128d hi = _mm_cvtps_pd(_mm_movehl_ps(diff, diff));
+			sum = _mm_add_pd(sum, _mm_add_pd(_mm_mul_pd(lo, lo), _mm_mul_pd(hi, hi)));
+		}
+
+		alignas(16) f64 sums[2];
+		alignas(16) f32 maxima[4];
+		_mm_store_pd(sums, sum);
+		_mm_store_ps(maxima, maxDiff);
+
+		f64 squared = sums[0] + sums[1];
+		f32 maxValue = *std::max_element(maxima, maxima + 4);
+		for (; i < count; ++i)
+		{
+			f32 diff = fabsf(a[i] - b[i]);
+			squared += (f64)diff * diff;
+			maxValue = std::max(maxValue, diff);
+		}
+
+		return{ squared, maxValue };
+	}
+
+	ErrorSum compareF16(const u16* a, const u16* b, u64 count)
+	{
+		ErrorSum result = { 0.0, 0.0f };
+		for (u64 i = 0; i < count; ++i)
+		{
+			f32 diff = fabsf(halfToFloat(a[i]) - halfToFloat(b[i]));
+			result.squared += (f64)diff * diff;
+			result.max = std::max(result.max, diff);
+		}
+
+		return result;
+	}
+
+	f32 getValue(const u8* p, u32 index, vx::gl::DataType dataType)
+	{
+		using vx::gl::DataType;
+
+		switch (dataType)
+		{
+		case DataType::Unsigned_Byte:
+			return p[index] * (1.0f / 255.0f);
+		case DataType::Unsigned_Short:
+			return reinterpret_cast<const u16*>(p)[index] * (1.0f / 65535.0f);
+		case DataType::Half_Float:
+			return halfToFloat(reinterpret_cast<const u16*>(p)[index]);
+		default:
+			return reinterpret_cast<const f32*>(p)[index];
+		}
+	}
+
+	void writeHeatmap(const u8* a, const u8* b, u32 pixelCount, u32 channels, u32 pixelSize, vx::gl::DataType dataType, f32 maxError, u8* heatmap, u64* differentPixels)
+	{
+		u64 different = 0;
+		for (u32 i = 0; i < pixelCount; ++i)
+		{
+			f32 error = 0.0f;
+			for (u32 c = 0; c < channels; ++c)
+			{
+				error = std::max(error, fabsf(getValue(a, c, dataType) - getValue(b, c, dataType)));
+			}
+
+			auto dst = heatmap + i * 4;
+			if (error == 0.0f)
+			{
+				dst[0] = dst[1] = dst[2] = 0;
+			}
+			else
+			{
+				f32 t = std::min(error / maxError, 1.0f);
+				dst[0] = static_cast<u8>(t * 255.0f + 0.5f);
+				dst[1] = 0;
+				dst[2] = static_cast<u8>((1.0f - t) * 255.0f + 0.5f);
+				++different;
+			}
+			dst[3] = 0xff;
+
+			a += pixelSize;
+			b += pixelSize;
+		}
+
+		*differentPixels = different;
+	}
+
+	u64 countDifferentPixels(const u8* a, const u8* b, u64 pixelCount, u32 pixelSize)
+	{
+		u64 different = 0;
+		for (u64 i = 0; i < pixelCount; ++i)
+		{
+			if (memcmp(a, b, pixelSize) != 0)
+				++different;
+
+			a += pixelSize;
+			b += pixelSize;
+		}
+
+		return different;
+	}
+}
+
+namespace vx
+{
+	namespace gl
+	{
+		bool compareImages(const void* a, const void* b, u32 width, u32 height, TextureFormat format, DataType dataType, ImageCompareResult* result, u8* heatmap)
+		{
+			auto &traits = getTextureFormatTraits(format);
+			if (traits.compressed != 0)
+				return false;
+
+			auto pa = static_cast<const u8*>(a);
+			auto pb = static_cast<const u8*>(b);
+			u64 pixelCount = (u64)width * height;
+			u64 count = pixelCount * traits.channels;
+
+			ImageCompareCpp::ErrorSum error;
+			switch (dataType)
+			{
+			case DataType::Unsigned_Byte:
+				error = ImageCompareCpp::compareU8(pa, pb, count);
+				break;
+			case DataType::Unsigned_Short:
+				error = ImageCompareCpp::compareU16(reinterpret_cast<const u16*>(pa), reinterpret_cast<const u16*>(pb), count);
+				break;
+			case DataType::Half_Float:
+				error = ImageCompareCpp::compareF16(reinterpret_cast<const u16*>(pa), reinterpret_cast<const u16*>(pb), count);
+				break;
+			case DataType::Float:
+				error = ImageCompareCpp::compareF32(reinterpret_cast<const f32*>(pa), reinterpret_cast<const f32*>(pb), count);
+				break;
+			default:
+				return false;
+			}
+
+			result->meanSquaredError = (count != 0) ? error.squared / count : 0.0;
+			result->psnr = (result->meanSquaredError > 0.0) ? 10.0 * log10(1.0 / result->meanSquaredError) : std::numeric_limits<f64>::infinity();
+			result->maxError = error.max;
+
+			u32 pixelSize = getPixelSize(format, dataType);
+			if (heatmap)
+			{
+				ImageCompareCpp::writeHeatmap(pa, pb, static_cast<u32>(pixelCount), traits.channels, pixelSize, dataType, error.max, heatmap, &result->differentPixels);
+			}
+			else
+			{
+				result->differentPixels = (error.max == 0.0f) ? 0 : ImageCompareCpp::countDifferentPixels(pa, pb, pixelCount, pixelSize);
+			}
+
+			return true;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,233 @@
+/*
+The MIT License(MIT)
+
+Copyright(c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/ImageDecodePool.h>
+#include <algorithm>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+
+namespace ImageDecodePoolCpp
+{
+	bool readFile(const char* file, std::unique_ptr<u8[]>* data, u64* size)
+	{
+		std::ifstream inFile(file, std::ios::binary | std::ios::ate);
+		if (!inFile.is_open())
+			return false;
+
+		auto end = inFile.tellg();
+		if (end < 0)
+			return false;
+
+		*size = end;
+		inFile.seekg(0, std::ios::beg);
+
+		*data = std::unique_ptr<u8[]>(new u8[*size]);
+		inFile.read(reinterpret_cast<char*>(data->get()), *size);
+
+		return inFile.good();
+	}
+}
+
+namespace vx
+{
+	namespace gl
+	{
+		ImageDecodePool::ImageDecodePool()
+			:m_threads(),
+			m_jobs(),
+			m_results(),
+			m_jobMutex(),
+			m_resultMutex(),
+			m_jobCondition(),
+			m_pendingJobs(0),
+			m_running(false)
+		{
+		}
+
+		ImageDecodePool::~ImageDecodePool()
+		{
+			shutdown();
+		}
+
+		void ImageDecodePool::initialize(u32 threadCount)
+		{
+			if (m_running)
+				return;
+
+			if (threadCount == 0)
+			{
+				auto hardwareThreads = std::thread::hardware_concurrency();
+				threadCount = (hardwareThreads > 1) ? hardwareThreads - 1 : 1;
+			}
+
+			m_running = true;
+			m_threads.reserve(threadCount);
+			for (u32 i = 0; i < threadCount; ++i)
+			{
+				m_threads.push_back(std::thread(&ImageDecodePool::workerMain, this));
+			}
+		}
+
+		void ImageDecodePool::shutdown()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_jobMutex);
+				if (!m_running)
+					return;
+
+				m_running = false;
+				m_jobs.clear();
+			}
+			m_jobCondition.notify_all();
+
+			for (auto &it : m_threads)
+			{
+				it.join();
+			}
+			m_threads.clear();
+
+			std::lock_guard<std::mutex> lock(m_resultMutex);
+			m_results.clear();
+			m_pendingJobs = 0;
+		}
+
+		void ImageDecodePool::workerMain()
+		{
+			while (true)
+			{
+				Job job;
+				{
+					std::unique_lock<std::mutex> lock(m_jobMutex);
+					m_jobCondition.wait(lock, [this]() { return !m_running || !m_jobs.empty(); });
+
+					if (!m_running)
+						break;
+
+					job = std::move(m_jobs.front());
+					m_jobs.pop_front();
+				}
+
+				ImageDecodeResult result;
+				result.userId = job.userId;
+
+				// an exception would terminate the process, a bad file only fails its own job
+				try
+				{
+					std::unique_ptr<u8[]> file;
+					u64 fileSize = 0;
+					if (ImageDecodePoolCpp::readFile(job.file.c_str(), &file, &fileSize))
+					{
+						result.success = ImageDecoder::decode(file.get(), fileSize, job.flipY, &result.image, &result.error);
+
+						if (result.success && job.convert)
+						{
+							file.reset();
+							result.success = ImageDecoder::convert(&result.image, job.targetFormat, &result.error);
+						}
+					}
+					else
+					{
+						result.error = "could not open file '" + job.file + "'\n";
+					}
+				}
+				catch (const std::bad_alloc&)
+				{
+					result.image = DecodedImage();
+					result.success = false;
+					result.error = "out of memory while decoding '" + job.file + "'\n";
+				}
+				catch (const std::exception &e)
+				{
+					result.image = DecodedImage();
+					result.success = false;
+					result.error = "error decoding '" + job.file + "': " + e.what() + "\n";
+				}
+
+				std::lock_guard<std::mutex> lock(m_resultMutex);
+				m_results.push_back(std::move(result));
+			}
+		}
+
+		void ImageDecodePool::pushJob(Job &&job)
+		{
+			VX_ASSERT(m_running);
+
+			{
+				std::lock_guard<std::mutex> lock(m_jobMutex);
+				m_jobs.push_back(std::move(job));
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(m_resultMutex);
+				++m_pendingJobs;
+			}
+
+			m_jobCondition.notify_one();
+		}
+
+		void ImageDecodePool::push(const char* file, u32 userId, bool flipY)
+		{
+			Job job;
+			job.file = file;
+			job.userId = userId;
+			job.flipY = flipY;
+			job.convert = false;
+			job.targetFormat = TextureFormat::RGBA8;
+			pushJob(std::move(job));
+		}
+
+		void ImageDecodePool::push(const char* file, u32 userId, bool flipY, TextureFormat targetFormat)
+		{
+			Job job;
+			job.file = file;
+			job.userId = userId;
+			job.flipY = flipY;
+			job.convert = true;
+			job.targetFormat = targetFormat;
+			pushJob(std::move(job));
+		}
+
+		u32 ImageDecodePool::pop(std::vector<ImageDecodeResult>* results)
+		{
+			std::lock_guard<std::mutex> lock(m_resultMutex);
+
+			u32 count = static_cast<u32>(m_results.size());
+			for (auto &it : m_results)
+			{
+				results->push_back(std::move(it));
+			}
+			m_results.clear();
+			m_pendingJobs -= count;
+
+			return count;
+		}
+
+		u32 ImageDecodePool::getPendingJobCount()
+		{
+			std::lock_guard<std::mutex> lock(m_resultMutex);
+			return m_pendingJobs;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,1022 @@
+/*
+The MIT License(MIT)
+
+Copyright(c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/ImageDecoder.h>
+#include <vxGL/Texture.h>
+#include <vxGL/PixelConversion.h>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace ImageDecoderCpp
+{
+	// larger images are rejected before anything is allocated
+	const u32 g_maxImageSize = 16384;
+
+	bool checkImageSize(u64 width, u64 height, const char* fileType, std::string* error)
+	{
+		if (width == 0 || height == 0 || width > g_maxImageSize || height > g_maxImageSize)
+		{
+			error->append(fileType);
+			error->append(": invalid image size\n");
+			return false;
+		}
+
+		return true;
+	}
+
+	struct BitReader
+	{
+		const u8* data;
+		u64 size;
+		u64 position;
+		u32 bitBuffer;
+		u32 bitCount;
+		bool overflow;
+	};
+
+	u32 getBits(BitReader* reader, u32 count)
+	{
+		u32 value = reader->bitBuffer;
+		while (reader->bitCount < count)
+		{
+			if (reader->position >= reader->size)
+			{
+				reader->overflow = true;
+				return 0;
+			}
+
+			value |= (u32)reader->data[reader->position++] << reader->bitCount;
+			reader->bitCount += 8;
+		}
+
+		reader->bitBuffer = value >> count;
+		reader->bitCount -= count;
+
+		return value & ((1u << count) - 1u);
+	}
+
+	// canonical huffman table, codes are decoded one bit at a time
+	struct Huffman
+	{
+		u16 count[16];
+		u16 symbol[288];
+	};
+
+	bool buildHuffman(Huffman* h, const u8* lengths, u32 n)
+	{
+		memset(h->count, 0, sizeof(h->count));
+		for (u32 i = 0; i < n; ++i)
+		{
+			++h->count[lengths[i]];
+		}
+
+		if (h->count[0] == n)
+			return true;
+
+		s32 left = 1;
+		for (u32 len = 1; len < 16; ++len)
+		{
+			left <<= 1;
+			left -= h->count[len];
+			if (left < 0)
+				return false;
+		}
+
+		u16 offsets[16];
+		offsets[1] = 0;
+		for (u32 len = 1; len < 15; ++len)
+		{
+			offsets[len + 1] = offsets[len] + h->count[len];
+		}
+
+		for (u32 i = 0; i < n; ++i)
+		{
+			if (lengths[i] != 0)
+			{
+				h->symbol[offsets[lengths[i]]++] = (u16)i;
+			}
+		}
+
+		return true;
+	}
+
+	s32 decodeSymbol(BitReader* reader, const Huffman &h)
+	{
+		s32 code = 0;
+		s32 first = 0;
+		s32 index = 0;
+		for (u32 len = 1; len < 16; ++len)
+		{
+			code |= getBits(reader, 1);
+			if (reader->overflow)
+				return -1;
+
+			s32 count = h.count[len];
+			if (code - count < first)
+				return h.symbol[index + (code - first)];
+
+			index += count;
+			first += count;
+			first <<= 1;
+			code <<= 1;
+		}
+
+		return -1;
+	}
+
+	const u16 g_lengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+	const u8 g_lengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+	const u16 g_distanceBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+	const u8 g_distanceExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+	bool inflateCodes(BitReader* reader, const Huffman &lengthCodes, const Huffman &distanceCodes, u8* out, u64 outSize, u64* outPosition)
+	{
+		auto position = *outPosition;
+		while (true)
+		{
+			auto symbol = decodeSymbol(reader, lengthCodes);
+			if (symbol < 0)
+				return false;
+
+			if (symbol < 256)
+			{
+				if (position >= outSize)
+					return false;
+
+				out[position++] = (u8)symbol;
+			}
+			else if (symbol == 256)
+			{
+				break;
+			}
+			else
+			{
+				symbol -= 257;
+				if (symbol >= 29)
+					return false;
+
+				u32 length = g_lengthBase[symbol] + getBits(reader, g_lengthExtra[symbol]);
+
+				auto distanceSymbol = decodeSymbol(reader, distanceCodes);
+				if (distanceSymbol < 0 || distanceSymbol >= 30)
+					return false;
+
+				u32 distance = g_distanceBase[distanceSymbol] + getBits(reader, g_distanceExtra[distanceSymbol]);
+				if (reader->overflow || distance > position || position + length > outSize)
+					return false;
+
+				auto src = out + position - distance;
+				auto dst = out + position;
+				for (u32 i = 0; i < length; ++i)
+				{
+					dst[i] = src[i];
+				}
+				position += length;
+			}
+		}
+
+		*outPosition = position;
+		return true;
+	}
+
+	bool inflateFixed(BitReader* reader, u8* out, u64 outSize, u64* outPosition)
+	{
+		u8 lengths[288];
+		u32 i = 0;
+		for (; i < 144; ++i) lengths[i] = 8;
+		for (; i < 256; ++i) lengths[i] = 9;
+		for (; i < 280; ++i) lengths[i] = 7;
+		for (; i < 288; ++i) lengths[i] = 8;
+
+		Huffman lengthCodes;
+		buildHuffman(&lengthCodes, lengths, 288);
+
+		for (i = 0; i < 30; ++i) lengths[i] = 5;
+
+		Huffman distanceCodes;
+		buildHuffman(&distanceCodes, lengths, 30);
+
+		return inflateCodes(reader, lengthCodes, distanceCodes, out, outSize, outPosition);
+	}
+
+	bool inflateDynamic(BitReader* reader, u8* out, u64 outSize, u64* outPosition)
+	{
+		const u8 order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+		u32 lengthCount = getBits(reader, 5) + 257;
+		u32 distanceCount = getBits(reader, 5) + 1;
+		u32 codeCount = getBits(reader, 4) + 4;
+		if (lengthCount > 286 || distanceCount > 30)
+			return false;
+
+		u8 lengths[320] = {};
+		for (u32 i = 0; i < codeCount; ++i)
+		{
+			lengths[order[i]] = (u8)getBits(reader, 3);
+		}
+
+		Huffman codeLengthCodes;
+		if (!buildHuffman(&codeLengthCodes, lengths, 19))
+			return false;
+
+		memset(lengths, 0, sizeof(lengths));
+
+		u32 index = 0;
+		while (index < lengthCount + distanceCount)
+		{
+			auto symbol = decodeSymbol(reader, codeLengthCodes);
+			if (symbol < 0)
+				return false;
+
+			if (symbol < 16)
+			{
+				lengths[index++] = (u8)symbol;
+				continue;
+			}
+
+			u8 value = 0;
+			u32 repeat = 0;
+			if (symbol == 16)
+			{
+				if (index == 0)
+					return false;
+
+				value = lengths[index - 1];
+				repeat = 3 + getBits(reader, 2);
+			}
+			else if (symbol == 17)
+			{
+				repeat = 3 + getBits(reader, 3);
+			}
+			else
+			{
+				repeat = 11 + getBits(reader, 7);
+			}
+
+			if (index + repeat > lengthCount + distanceCount)
+				return false;
+
+			while (repeat-- != 0)
+			{
+				lengths[index++] = value;
+			}
+		}
+
+		if (lengths[256] == 0)
+			return false;
+
+		Huffman lengthCodes, distanceCodes;
+		if (!buildHuffman(&lengthCodes, lengths, lengthCount) || !buildHuffman(&distanceCodes, lengths + lengthCount, distanceCount))
+			return false;
+
+		return inflateCodes(reader, lengthCodes, distanceCodes, out, outSize, outPosition);
+	}
+
+	// decompresses a zlib stream into a buffer of known size
+	bool inflateZlib(const u8* data, u64 size, u8* out, u64 outSize)
+	{
+		if (size < 2 || (data[0] & 0x0f) != 8 || ((data[0] << 8) | data[1]) % 31 != 0 || (data[1] & 0x20) != 0)
+			return false;
+
+		BitReader reader = { data + 2, size - 2, 0, 0, 0, false };
+		u64 position = 0;
+
+		u32 last = 0;
+		while (last == 0)
+		{
+			last = getBits(&reader, 1);
+			auto type = getBits(&reader, 2);
+
+			bool result = false;
+			if (type == 0)
+			{
+				reader.bitBuffer = 0;
+				reader.bitCount = 0;
+				if (reader.position + 4 > reader.size)
+					return false;
+
+				u32 length = reader.data[reader.position] | (reader.data[reader.position + 1] << 8);
+				reader.position += 4;
+				if (reader.position + length > reader.size || position + length > outSize)
+					return false;
+
+				memcpy(out + position, reader.data + reader.position, length);
+				reader.position += length;
+				position += length;
+				result = true;
+			}
+			else if (type == 1)
+			{
+				result = inflateFixed(&reader, out, outSize, &position);
+			}
+			else if (type == 2)
+			{
+				result = inflateDynamic(&reader, out, outSize, &position);
+			}
+
+			if (!result || reader.overflow)
+				return false;
+		}
+
+		return position == outSize;
+	}
+
+	u32 readBE32(const u8* p)
+	{
+		return ((u32)p[0] << 24) | ((u32)p[1] << 16) | ((u32)p[2] << 8) | p[3];
+	}
+
+	u16 readLE16(const u8* p)
+	{
+		return (u16)(p[0] | (p[1] << 8));
+	}
+
+	u8 paeth(s32 a, s32 b, s32 c)
+	{
+		auto p = a + b - c;
+		auto pa = abs(p - a);
+		auto pb = abs(p - b);
+		auto pc = abs(p - c);
+		if (pa <= pb && pa <= pc)
+			return (u8)a;
+		if (pb <= pc)
+			return (u8)b;
+		return (u8)c;
+	}
+
+	bool unfilter(u8* data, u32 height, u64 rowSize, u32 bpp)
+	{
+		const u8* prev = nullptr;
+		for (u32 y = 0; y < height; ++y)
+		{
+			auto filter = data[y * (rowSize + 1)];
+			auto row = data + y * (rowSize + 1) + 1;
+
+			switch (filter)
+			{
+			case 0:
+				break;
+			case 1:
+				for (u64 i = bpp; i < rowSize; ++i)
+					row[i] += row[i - bpp];
+				break;
+			case 2:
+				if (prev)
+				{
+					for (u64 i = 0; i < rowSize; ++i)
+						row[i] += prev[i];
+				}
+				break;
+			case 3:
+				for (u64 i = 0; i < rowSize; ++i)
+				{
+					u32 left = (i >= bpp) ? row[i - bpp] : 0;
+					u32 up = prev ? prev[i] : 0;
+					row[i] += (u8)((left + up) >> 1);
+				}
+				break;
+			case 4:
+				for (u64 i = 0; i < rowSize; ++i)
+				{
+					s32 left = (i >= bpp) ? row[i - bpp] : 0;
+					s32 up = prev ? prev[i] : 0;
+					s32 upLeft = (prev && i >= bpp) ? prev[i - bpp] : 0;
+					row[i] += paeth(left, up, upLeft);
+				}
+				break;
+			default:
+				return false;
+			}
+
+			prev = row;
+		}
+
+		return true;
+	}
+
+	void setFormat(vx::gl::DecodedImage* image, u32 channels, u32 bytesPerChannel)
+	{
+		using vx::gl::TextureFormat;
+		using vx::gl::DataType;
+
+		const TextureFormat formats8[4] = { TextureFormat::R8, TextureFormat::RG8, TextureFormat::RGBA8, TextureFormat::RGBA8 };
+		const TextureFormat formats16[4] = { TextureFormat::R16, TextureFormat::RG16, TextureFormat::RGBA16, TextureFormat::RGBA16 };
+
+		image->format = (bytesPerChannel == 1) ? formats8[channels - 1] : formats16[channels - 1];
+		image->dataType = (bytesPerChannel == 1) ? DataType::Unsigned_Byte : DataType::Unsigned_Short;
+	}
+
+	void allocate(vx::gl::DecodedImage* image, u32 width, u32 height, u32 pixelSize)
+	{
+		image->width = width;
+		image->height = height;
+		image->size = (u64)width * height * pixelSize;
+		image->data = std::unique_ptr<u8[]>(new u8[image->size]);
+	}
+}
+
+namespace vx
+{
+	namespace gl
+	{
+		ImageFileType ImageDecoder::getFileType(const u8* file, u64 fileSize)
+		{
+			const u8 pngSignature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+			if (fileSize >= 8 && memcmp(file, pngSignature, 8) == 0)
+				return ImageFileType::Png;
+
+			if (fileSize >= 2 && file[0] == '#' && file[1] == '?')
+				return ImageFileType::Hdr;
+
+			// tga has no signature, check for a supported image type
+			if (fileSize >= 18 && file[1] == 0 && (file[2] == 2 || file[2] == 3 || file[2] == 10 || file[2] == 11))
+				return ImageFileType::Tga;
+
+			return ImageFileType::Unknown;
+		}
+
+		bool ImageDecoder::decode(const u8* file, u64 fileSize, bool flipY, DecodedImage* image, std::string* error)
+		{
+			bool result = false;
+			switch (getFileType(file, fileSize))
+			{
+			case ImageFileType::Png:
+				result = decodePng(file, fileSize, image, error);
+				break;
+			case ImageFileType::Tga:
+				result = decodeTga(file, fileSize, image, error);
+				break;
+			case ImageFileType::Hdr:
+				result = decodeHdr(file, fileSize, image, error);
+				break;
+			default:
+				error->append("unknown image format\n");
+				break;
+			}
+
+			if (result && flipY)
+			{
+				flipVertical(image);
+			}
+
+			return result;
+		}
+
+		bool ImageDecoder::decodePng(const u8* file, u64 fileSize, DecodedImage* image, std::string* error)
+		{
+			u32 width = 0, height = 0;
+			u8 bitDepth = 0, colorType = 0, interlace = 0;
+			u8 palette[256 * 4];
+			u32 paletteSize = 0;
+			memset(palette, 0xff, sizeof(palette));
+
+			std::unique_ptr<u8[]> compressed;
+			u64 compressedSize = 0;
+			u64 compressedCapacity = 0;
+
+			u64 position = 8;
+			while (position + 12 <= fileSize)
+			{
+				auto length = ImageDecoderCpp::readBE32(file + position);
+				auto type = file + position + 4;
+				auto chunk = file + position + 8;
+				if (position + 12 + length > fileSize)
+					break;
+
+				if (memcmp(type, "IHDR", 4) == 0 && length >= 13)
+				{
+					width = ImageDecoderCpp::readBE32(chunk);
+					height = ImageDecoderCpp::readBE32(chunk + 4);
+					bitDepth = chunk[8];
+					colorType = chunk[9];
+					interlace = chunk[12];
+				}
+				else if (memcmp(type, "PLTE", 4) == 0)
+				{
+					paletteSize = std::min(length / 3, 256u);
+					for (u32 i = 0; i < paletteSize; ++i)
+					{
+						palette[i * 4 + 0] = chunk[i * 3 + 0];
+						palette[i * 4 + 1] = chunk[i * 3 + 1];
+						palette[i * 4 + 2] = chunk[i * 3 + 2];
+					}
+				}
+				else if (memcmp(type, "tRNS", 4) == 0 && colorType == 3)
+				{
+					for (u32 i = 0; i < std::min(length, 256u); ++i)
+					{
+						palette[i * 4 + 3] = chunk[i];
+					}
+				}
+				else if (memcmp(type, "IDAT", 4) == 0)
+				{
+					if (compressedSize + length > compressedCapacity)
+					{
+						compressedCapacity = std::max(compressedCapacity * 2, compressedSize + length);
+						auto newBuffer = std::unique_ptr<u8[]>(new u8[compressedCapacity]);
+						if (compressedSize != 0)
+						{
+							memcpy(newBuffer.get(), compressed.get(), compressedSize);
+						}
+						compressed = std::move(newBuffer);
+					}
+
+					memcpy(compressed.get() + compressedSize, chunk, length);
+					compressedSize += length;
+				}
+				else if (memcmp(type, "IEND", 4) == 0)
+				{
+					break;
+				}
+
+				position += 12 + length;
+			}
+
+			if (width == 0 || height == 0 || compressedSize == 0)
+			{
+				error->append("png: missing header or image data\n");
+				return false;
+			}
+
+			if (!ImageDecoderCpp::checkImageSize(width, height, "png", error))
+				return false;
+
+			if (interlace != 0)
+			{
+				error->append("png: interlaced images are not supported\n");
+				return false;
+			}
+
+			u32 channels = 0;
+			switch (colorType)
+			{
+			case 0: channels = 1; break;
+			case 2: channels = 3; break;
+			case 3: channels = 1; break;
+			case 4: channels = 2; break;
+			case 6: channels = 4; break;
+			default:
+				error->append("png: invalid color type\n");
+				return false;
+			}
+
+			if ((bitDepth != 8 && bitDepth != 16) || (colorType == 3 && bitDepth != 8))
+			{
+				error->append("png: only 8 and 16 bit images are supported\n");
+				return false;
+			}
+
+			u32 bytesPerChannel = bitDepth / 8;
+			u32 bpp = channels * bytesPerChannel;
+			u64 rowSize = (u64)width * bpp;
+			u64 rawSize = (rowSize + 1) * height;
+
+			// deflate cannot compress better than 1032:1
+			if (rawSize / 1032 > compressedSize)
+			{
+				error->append("png: truncated image data\n");
+				return false;
+			}
+
+			auto raw = std::unique_ptr<u8[]>(new u8[rawSize]);
+			if (!ImageDecoderCpp::inflateZlib(compressed.get(), compressedSize, raw.get(), rawSize))
+			{
+				error->append("png: corrupt image data\n");
+				return false;
+			}
+			compressed.reset();
+
+			if (!ImageDecoderCpp::unfilter(raw.get(), height, rowSize, bpp))
+			{
+				error->append("png: invalid filter\n");
+				return false;
+			}
+
+			if (colorType == 3)
+			{
+				ImageDecoderCpp::setFormat(image, 4, 1);
+				ImageDecoderCpp::allocate(image, width, height, 4);
+
+				auto dst = image->data.get();
+				for (u32 y = 0; y < height; ++y)
+				{
+					auto src = raw.get() + (u64)y * (rowSize + 1) + 1;
+					for (u32 x = 0; x < width; ++x)
+					{
+						memcpy(dst, palette + src[x] * 4, 4);
+						dst += 4;
+					}
+				}
+
+				return true;
+			}
+
+			// rgb is padded to rgba, 16 bit channels are swapped to little endian
+			u32 outChannels = (channels == 3) ? 4 : channels;
+			ImageDecoderCpp::setFormat(image, outChannels, bytesPerChannel);
+			ImageDecoderCpp::allocate(image, width, height, outChannels * bytesPerChannel);
+
+			PixelConversion expand;
+			getPixelConversion(TextureFormat::RGBA8, DataType::Unsigned_Byte, 3, false, &expand);
+
+			auto dst = image->data.get();
+			for (u32 y = 0; y < height; ++y)
+			{
+				auto src = raw.get() + (u64)y * (rowSize + 1) + 1;
+				if (bytesPerChannel == 1)
+				{
+					if (channels == 3)
+					{
+						convertPixels(expand, src, dst, width);
+						dst += (u64)width * 4;
+					}
+					else
+					{
+						memcpy(dst, src, rowSize);
+						dst += rowSize;
+					}
+				}
+				else
+				{
+					for (u32 x = 0; x < width; ++x)
+					{
+						for (u32 c = 0; c < outChannels; ++c)
+						{
+							if (c < channels)
+							{
+								dst[0] = src[1];
+								dst[1] = src[0];
+								src += 2;
+							}
+							else
+							{
+								dst[0] = 0xff;
+								dst[1] = 0xff;
+							}
+							dst += 2;
+						}
+					}
+				}
+			}
+
+			return true;
+		}
+
+		bool ImageDecoder::decodeTga(const u8* file, u64 fileSize, DecodedImage* image, std::string* error)
+		{
+			if (fileSize < 18)
+			{
+				error->append("tga: file too small\n");
+				return false;
+			}
+
+			u32 idLength = file[0];
+			u32 colorMapType = file[1];
+			u32 imageType = file[2];
+			u32 width = ImageDecoderCpp::readLE16(file + 12);
+			u32 height = ImageDecoderCpp::readLE16(file + 14);
+			u32 pixelDepth = file[16];
+			bool topLeft = (file[17] & 0x20) != 0;
+
+			bool rle = (imageType == 10 || imageType == 11);
+			bool gray = (imageType == 3 || imageType == 11);
+			if (colorMapType != 0 || (gray && pixelDepth != 8) || (!gray && pixelDepth != 24 && pixelDepth != 32))
+			{
+				error->append("tga: unsupported pixel format\n");
+				return false;
+			}
+
+			if (!ImageDecoderCpp::checkImageSize(width, height, "tga", error))
+				return false;
+
+			u32 srcPixelSize = pixelDepth / 8;
+			u32 dstPixelSize = gray ? 1 : 4;
+			u64 position = 18 + idLength;
+			u64 pixelCount = (u64)width * height;
+
+			// a run length packet covers at most 128 pixels
+			u64 available = (fileSize > position) ? fileSize - position : 0;
+			u64 maxPixels = rle ? (available / (srcPixelSize + 1)) * 128 : available / srcPixelSize;
+			if (pixelCount > maxPixels)
+			{
+				error->append("tga: truncated image data\n");
+				return false;
+			}
+
+			ImageDecoderCpp::setFormat(image, dstPixelSize, 1);
+			ImageDecoderCpp::allocate(image, width, height, dstPixelSize);
+			u64 pixel = 0;
+
+			auto writePixel = [&](const u8* src)
+			{
+				// tga stores rows bottom to top unless the origin bit is set
+				auto x = pixel % width;
+				auto y = pixel / width;
+				auto row = topLeft ? y : (height - 1 - y);
+				auto dst = image->data.get() + ((u64)row * width + x) * dstPixelSize;
+
+				if (gray)
+				{
+					dst[0] = src[0];
+				}
+				else
+				{
+					dst[0] = src[2];
+					dst[1] = src[1];
+					dst[2] = src[0];
+					dst[3] = (srcPixelSize == 4) ? src[3] : 0xff;
+				}
+				++pixel;
+			};
+
+			if (!rle)
+			{
+				// the size was checked above, bgr(a) rows are swizzled to rgba at once
+				PixelConversion conversion;
+				if (!gray)
+				{
+					getPixelConversion(TextureFormat::RGBA8, DataType::Unsigned_Byte, srcPixelSize, true, &conversion);
+				}
+
+				for (u32 y = 0; y < height; ++y)
+				{
+					auto row = topLeft ? y : (height - 1 - y);
+					auto src = file + position + (u64)y * width * srcPixelSize;
+					auto dst = image->data.get() + (u64)row * width * dstPixelSize;
+
+					if (gray)
+					{
+						memcpy(dst, src, width);
+					}
+					else
+					{
+						convertPixels(conversion, src, dst, width);
+					}
+				}
+
+				return true;
+			}
+
+			while (pixel < pixelCount)
+			{
+				if (position >= fileSize)
+					break;
+
+				u32 header = file[position++];
+				u32 count = (header & 0x7f) + 1;
+				if (header & 0x80)
+				{
+					if (position + srcPixelSize > fileSize)
+						break;
+
+					for (u32 i = 0; i < count && pixel < pixelCount; ++i)
+						writePixel(file + position);
+					position += srcPixelSize;
+				}
+				else
+				{
+					for (u32 i = 0; i < count && pixel < pixelCount; ++i)
+					{
+						if (position + srcPixelSize > fileSize)
+							break;
+
+						writePixel(file + position);
+						position += srcPixelSize;
+					}
+				}
+			}
+
+			if (pixel != pixelCount)
+			{
+				error->append("tga: truncated image data\n");
+				return false;
+			}
+
+			return true;
+		}
+
+		bool ImageDecoder::decodeHdr(const u8* file, u64 fileSize, DecodedImage* image, std::string* error)
+		{
+			u64 position = 0;
+			auto readLine = [&](char* line, u32 maxSize)
+			{
+				u32 size = 0;
+				while (position < fileSize && file[position] != '\n')
+				{
+					if (size + 1 < maxSize)
+						line[size++] = (char)file[position];
+					++position;
+				}
+				++position;
+				line[size] = '\0';
+				return size;
+			};
+
+			char line[256];
+			bool rgbe = false;
+			while (position < fileSize)
+			{
+				if (readLine(line, sizeof(line)) == 0)
+					break;
+
+				if (strcmp(line, "FORMAT=32-bit_rle_rgbe") == 0)
+					rgbe = true;
+			}
+
+			s32 width = 0, height = 0;
+			readLine(line, sizeof(line));
+			if (!rgbe || sscanf(line, "-Y %d +X %d", &height, &width) != 2 || width <= 0 || height <= 0)
+			{
+				error->append("hdr: unsupported header\n");
+				return false;
+			}
+
+			if (!ImageDecoderCpp::checkImageSize(width, height, "hdr", error))
+				return false;
+
+			// smallest possible scanline, flat scanlines or run length encoded channels with runs of 127 pixels
+			u64 minScanlineSize = (width >= 8) ? 4 + 4 * 2 * (((u64)width + 126) / 127) : (u64)width * 4;
+			if (position > fileSize || minScanlineSize * height > fileSize - position)
+			{
+				error->append("hdr: truncated image data\n");
+				return false;
+			}
+
+			ImageDecoderCpp::allocate(image, width, height, 16);
+			image->format = TextureFormat::RGBA32F;
+			image->dataType = DataType::Float;
+
+			u64 scanlineSize = (u64)width * 4;
+			auto scanline = std::unique_ptr<u8[]>(new u8[scanlineSize]);
+			auto dst = reinterpret_cast<f32*>(image->data.get());
+
+			for (s32 y = 0; y < height; ++y)
+			{
+				if (position + 4 > fileSize)
+				{
+					error->append("hdr: truncated image data\n");
+					return false;
+				}
+
+				auto p = file + position;
+				bool newRle = (width >= 8 && width < 32768 && p[0] == 2 && p[1] == 2 && ((p[2] << 8) | p[3]) == width);
+				if (newRle)
+				{
+					position += 4;
+
+					// channels are stored one after another, each run length encoded
+					for (u32 c = 0; c < 4; ++c)
+					{
+						s32 x = 0;
+						while (x < width)
+						{
+							if (position >= fileSize)
+							{
+								error->append("hdr: truncated image data\n");
+								return false;
+							}
+
+							u32 count = file[position++];
+							if (count > 128)
+							{
+								count -= 128;
+								if (x + (s32)count > width || position >= fileSize)
+								{
+									error->append("hdr: invalid run length\n");
+									return false;
+								}
+
+								auto value = file[position++];
+								for (u32 i = 0; i < count; ++i)
+									scanline[(x++) * 4 + c] = value;
+							}
+							else
+							{
+								if (count == 0 || x + (s32)count > width || position + count > fileSize)
+								{
+									error->append("hdr: invalid run length\n");
+									return false;
+								}
+
+								for (u32 i = 0; i < count; ++i)
+									scanline[(x++) * 4 + c] = file[position++];
+							}
+						}
+					}
+				}
+				else
+				{
+					if (position + scanlineSize > fileSize)
+					{
+						error->append("hdr: truncated image data\n");
+						return false;
+					}
+
+					memcpy(scanline.get(), file + position, scanlineSize);
+					position += scanlineSize;
+				}
+
+				for (s32 x = 0; x < width; ++x)
+				{
+					auto src = scanline.get() + x * 4;
+					f32 scale = (src[3] == 0) ? 0.0f : ldexpf(1.0f, (s32)src[3] - (128 + 8));
+
+					dst[0] = src[0] * scale;
+					dst[1] = src[1] * scale;
+					dst[2] = src[2] * scale;
+					dst[3] = 1.0f;
+					dst += 4;
+				}
+			}
+
+			return true;
+		}
+
+		void ImageDecoder::flipVertical(DecodedImage* image)
+		{
+			auto rowSize = image->size / image->height;
+			auto tmp = std::unique_ptr<u8[]>(new u8[rowSize]);
+
+			for (u32 y = 0; y < image->height / 2; ++y)
+			{
+				auto top = image->data.get() + y * rowSize;
+				auto bottom = image->data.get() + (image->height - 1 - y) * rowSize;
+
+				memcpy(tmp.get(), top, rowSize);
+				memcpy(top, bottom, rowSize);
+				memcpy(bottom, tmp.get(), rowSize);
+			}
+		}
+
+		bool ImageDecoder::convert(DecodedImage* image, TextureFormat target, std::string* error)
+		{
+			if (image->format == target)
+				return true;
+
+			auto &srcTraits = getTextureFormatTraits(image->format);
+			auto &dstTraits = getTextureFormatTraits(target);
+
+			PixelConversion conversion;
+			if (!getPixelConversion(target, image->dataType, srcTraits.channels, false, &conversion))
+			{
+				// same transfer layout, for example RGBA8 into SRGBA8
+				if (srcTraits.channels == dstTraits.channels && dstTraits.dataType == image->dataType && dstTraits.compressed == 0)
+				{
+					image->format = target;
+					return true;
+				}
+
+				error->append("no pixel conversion to the target format\n");
+				return false;
+			}
+
+			u64 pixelCount = (u64)image->width * image->height;
+			u64 size = pixelCount * conversion.dstPixelSize;
+			auto data = std::unique_ptr<u8[]>(new u8[size]);
+			convertPixels(conversion, image->data.get(), data.get(), pixelCount);
+
+			image->data = std::move(data);
+			image->size = size;
+			image->format = target;
+			image->dataType = conversion.dstDataType;
+
+			return true;
+		}
+
+		void ImageDecoder::upload(const Texture &texture, const DecodedImage &image, u32 miplevel, u32 layer)
+		{
+			VX_ASSERT(getPixelSize(texture.getTextureFormat(), image.dataType) == getPixelSize(image.format, image.dataType));
+
+			TextureSubImageDescription desc;
+			desc.miplevel = miplevel;
+			desc.offset = vx::uint3{ 0, 0, layer };
+			desc.size = vx::uint3{ image.width, image.height, 1 };
+			desc.dataType = image.dataType;
+			desc.p = image.data.get();
+
+			texture.subImageBatch(&desc, 1);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,254 @@
+/*
+The MIT License(MIT)
+
+Copyright(c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/IndirectBatch.h>
+#include <vxGL/StateManager.h>
+#include <vxGL/gl.h>
+#include <algorithm>
+
+namespace IndirectBatchCpp
+{
+	bool isEqual(const vx::gl::IndirectBatchKey &l, const vx::gl::IndirectBatchKey &r)
+	{
+		return l.pipeline == r.pipeline && l.vao == r.vao && l.state == r.state && l.mode == r.mode && l.indexType == r.indexType;
+	}
+
+	// pipeline changes are the most expensive, then vao and then user state
+	bool isLess(const vx::gl::IndirectBatchKey &l, const vx::gl::IndirectBatchKey &r)
+	{
+		if (l.pipeline != r.pipeline)
+			return l.pipeline < r.pipeline;
+		if (l.vao != r.vao)
+			return l.vao < r.vao;
+		if (l.state != r.state)
+			return l.state < r.state;
+		if (l.mode != r.mode)
+			return l.mode < r.mode;
+
+		return l.indexType < r.indexType;
+	}
+}
+
+namespace vx
+{
+	namespace gl
+	{
+		IndirectBatch::IndirectBatch()
+			:m_buckets(),
+			m_order(),
+			m_chunkBuckets(),
+			m_staging(),
+			m_counts(),
+			m_commandBuffer(),
+			m_countBuffer(),
+			m_stateCallback(nullptr),
+			m_userData(nullptr),
+			m_maxCommands(0),
+			m_maxBuckets(0),
+			m_region(0),
+			m_regionCount(0),
+			m_lastBucket(0),
+			m_drawCallCount(0),
+			m_useDrawCountBuffer(false)
+		{
+		}
+
+		IndirectBatch::~IndirectBatch()
+		{
+			destroy();
+		}
+
+		void IndirectBatch::create(const IndirectBatchDescription &desc)
+		{
+			VX_ASSERT(desc.maxCommands != 0 && desc.maxBuckets != 0 && desc.frameCount != 0);
+
+			destroy();
+
+			m_stateCallback = desc.stateCallback;
+			m_userData = desc.userData;
+			m_maxCommands = desc.maxCommands;
+			m_maxBuckets = desc.maxBuckets;
+			m_regionCount = desc.frameCount;
+			m_useDrawCountBuffer = desc.useDrawCountBuffer;
+
+			m_staging.reserve(m_maxCommands);
+			m_counts.reserve(m_maxBuckets);
+			m_chunkBuckets.reserve(m_maxBuckets);
+
+			auto commandSize = sizeof(DrawElementsIndirectCommand) * m_maxCommands * m_regionCount;
+			m_commandBuffer = BufferDescription::createImmutable(BufferType::Draw_Indirect_Buffer, commandSize, BufferStorageFlags::Dynamic_Storage, nullptr);
+
+			if (m_useDrawCountBuffer)
+			{
+				auto countSize = sizeof(u32) * m_maxBuckets * m_regionCount;
+				m_countBuffer = BufferDescription::createImmutable(BufferType::Parameter_Buffer, countSize, BufferStorageFlags::Dynamic_Storage, nullptr);
+			}
+		}
+
+		void IndirectBatch::destroy()
+		{
+			m_commandBuffer.destroy();
+			m_countBuffer.destroy();
+			m_buckets.clear();
+			m_region = 0;
+			m_regionCount = 0;
+			m_lastBucket = 0;
+		}
+
+		u32 IndirectBatch::getBucket(const IndirectBatchKey &key)
+		{
+			// consecutive draws usually go to the same bucket
+			if (m_lastBucket < m_buckets.size() && IndirectBatchCpp::isEqual(m_buckets[m_lastBucket].key, key))
+				return m_lastBucket;
+
+			for (u32 i = 0; i < m_buckets.size(); ++i)
+			{
+				if (IndirectBatchCpp::isEqual(m_buckets[i].key, key))
+				{
+					m_lastBucket = i;
+					return i;
+				}
+			}
+
+			Bucket bucket;
+			bucket.key = key;
+			m_buckets.push_back(std::move(bucket));
+
+			m_lastBucket = static_cast<u32>(m_buckets.size() - 1);
+			return m_lastBucket;
+		}
+
+		void IndirectBatch::add(u32 bucket, const DrawElementsIndirectCommand &command)
+		{
+			m_buckets[bucket].commands.push_back(command);
+		}
+
+		void IndirectBatch::drawChunk(const IndirectBatchKey** current)
+		{
+			// the driver orders subData after the draws that still read the region, rotating regions lets it avoid a stall
+			auto commandOffset = sizeof(DrawElementsIndirectCommand) * m_maxCommands * m_region;
+			m_commandBuffer.subData(commandOffset, sizeof(DrawElementsIndirectCommand) * m_staging.size(), m_staging.data());
+			StateManager::bindBuffer(BufferType::Draw_Indirect_Buffer, m_commandBuffer);
+
+			auto countOffset = sizeof(u32) * m_maxBuckets * m_region;
+			if (m_useDrawCountBuffer)
+			{
+				m_countBuffer.subData(countOffset, sizeof(u32) * m_counts.size(), m_counts.data());
+				StateManager::bindBuffer(BufferType::Parameter_Buffer, m_countBuffer);
+			}
+
+			for (u32 i = 0; i < m_chunkBuckets.size(); ++i)
+			{
+				auto &key = m_buckets[m_chunkBuckets[i]].key;
+				auto previous = *current;
+				if (!previous || previous->pipeline != key.pipeline)
+					StateManager::bindPipeline(key.pipeline);
+				if (!previous || previous->vao != key.vao)
+					StateManager::bindVertexArray(key.vao);
+				if (m_stateCallback && (!previous || previous->state != key.state))
+					m_stateCallback(key.state, m_userData);
+				*current = &key;
+
+				auto count = m_counts[i];
+				if (m_useDrawCountBuffer)
+				{
+					glMultiDrawElementsIndirectCountARB((u32)key.mode, (u32)key.indexType, commandOffset, countOffset + sizeof(u32) * i, count, 0);
+				}
+				else
+				{
+					glMultiDrawElementsIndirect((u32)key.mode, (u32)key.indexType, (const void*)commandOffset, count, 0);
+				}
+				++m_drawCallCount;
+
+				commandOffset += sizeof(DrawElementsIndirectCommand) * count;
+			}
+
+			m_region = (m_region + 1) % m_regionCount;
+		}
+
+		void IndirectBatch::submit()
+		{
+			m_drawCallCount = 0;
+
+			m_order.clear();
+			for (u32 i = 0; i < m_buckets.size(); ++i)
+			{
+				if (!m_buckets[i].commands.empty())
+					m_order.push_back(i);
+			}
+
+			if (m_order.empty())
+				return;
+
+			std::sort(m_order.begin(), m_order.end(), [this](u32 l, u32 r)
+			{
+				return IndirectBatchCpp::isLess(m_buckets[l].key, m_buckets[r].key);
+			});
+
+			// fills one region at a time, buckets with more commands than fit are split between chunks
+			const IndirectBatchKey* current = nullptr;
+			u32 orderIndex = 0;
+			u32 firstCommand = 0;
+			while (orderIndex < m_order.size())
+			{
+				m_staging.clear();
+				m_counts.clear();
+				m_chunkBuckets.clear();
+
+				while (orderIndex < m_order.size() && m_staging.size() < m_maxCommands && m_counts.size() < m_maxBuckets)
+				{
+					auto &commands = m_buckets[m_order[orderIndex]].commands;
+					auto count = std::min(static_cast<u32>(commands.size()) - firstCommand, m_maxCommands - static_cast<u32>(m_staging.size()));
+
+					m_staging.insert(m_staging.end(), commands.begin() + firstCommand, commands.begin() + firstCommand + count);
+					m_counts.push_back(count);
+					m_chunkBuckets.push_back(m_order[orderIndex]);
+
+					firstCommand += count;
+					if (firstCommand == commands.size())
+					{
+						++orderIndex;
+						firstCommand = 0;
+					}
+				}
+
+				drawChunk(&current);
+			}
+
+			for (auto &it : m_buckets)
+			{
+				it.commands.clear();
+			}
+		}
+
+		void IndirectBatch::drawIndirectCount(PrimitveType mode, DataType indexType, const Buffer &commandBuffer, u32 commandOffset,
+			const Buffer &drawCountBuffer, u32 drawCountOffset, u32 maxDrawCount)
+		{
+			StateManager::bindBuffer(BufferType::Draw_Indirect_Buffer, commandBuffer);
+			StateManager::bindBuffer(BufferType::Parameter_Buffer, drawCountBuffer);
+
+			glMultiDrawElementsIndirectCountARB((u32)mode, (u32)indexType, commandOffset, drawCountOffset, maxDrawCount, 0);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,149 @@
+/*
+The MIT License(MIT)
+
+Copyright(c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/PipelinePrewarmer.h>
+#include <vxGL/ProgramPipeline.h>
+#include <vxGL/gl.h>
+#include <algorithm>
+#include <chrono>
+
+namespace vx
+{
+	namespace gl
+	{
+		PipelinePrewarmer::PipelinePrewarmer()
+			:m_times(),
+			m_vao(0),
+			m_emptyVao(0),
+			m_framebuffer(0),
+			m_savedState(),
+			m_savedDiscard(false)
+		{
+		}
+
+		PipelinePrewarmer::~PipelinePrewarmer()
+		{
+			destroy();
+		}
+
+		void PipelinePrewarmer::setState(u32 vao, u32 framebuffer)
+		{
+			m_vao = vao;
+			m_framebuffer = framebuffer;
+		}
+
+		void PipelinePrewarmer::destroy()
+		{
+			if (m_emptyVao != 0)
+			{
+				glDeleteVertexArrays(1, &m_emptyVao);
+				m_emptyVao = 0;
+			}
+		}
+
+		void PipelinePrewarmer::begin()
+		{
+			glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &m_savedState[0]);
+			glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &m_savedState[1]);
+			glGetIntegerv(GL_PROGRAM_PIPELINE_BINDING, &m_savedState[2]);
+			glGetIntegerv(GL_CURRENT_PROGRAM, &m_savedState[3]);
+			glGetIntegerv(GL_PATCH_VERTICES, &m_savedState[4]);
+			m_savedDiscard = (glIsEnabled(GL_RASTERIZER_DISCARD) == GL_TRUE);
+
+			auto vao = m_vao;
+			if (vao == 0)
+			{
+				if (m_emptyVao == 0)
+				{
+					glCreateVertexArrays(1, &m_emptyVao);
+				}
+				vao = m_emptyVao;
+			}
+
+			glBindVertexArray(vao);
+			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_framebuffer);
+			// a bound program overrides the pipeline
+			glUseProgram(0);
+			glPatchParameteri(GL_PATCH_VERTICES, 3);
+			glEnable(GL_RASTERIZER_DISCARD);
+		}
+
+		void PipelinePrewarmer::end()
+		{
+			if (!m_savedDiscard)
+			{
+				glDisable(GL_RASTERIZER_DISCARD);
+			}
+
+			glPatchParameteri(GL_PATCH_VERTICES, m_savedState[4]);
+			glUseProgram(m_savedState[3]);
+			glBindProgramPipeline(m_savedState[2]);
+			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_savedState[1]);
+			glBindVertexArray(m_savedState[0]);
+		}
+
+		void PipelinePrewarmer::warm(const vx::StringID &sid, const ProgramPipeline &pipeline)
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			pipeline.bind();
+			if (pipeline[ShaderProgramType::COMPUTE] != 0)
+			{
+				glDispatchCompute(0, 0, 0);
+			}
+			else
+			{
+				bool tessellation = pipeline[ShaderProgramType::TESS_CONTROL] != 0 || pipeline[ShaderProgramType::TESS_EVAL] != 0;
+				glDrawArrays(tessellation ? GL_PATCHES : GL_TRIANGLES, 0, 3);
+			}
+
+			// drivers that compile on a worker thread only block here
+			glFinish();
+
+			auto end = std::chrono::high_resolution_clock::now();
+
+			PipelinePrewarmTime time;
+			time.sid = sid;
+			time.milliseconds = std::chrono::duration<f32, std::milli>(end - start).count();
+			m_times.push_back(time);
+		}
+
+		void PipelinePrewarmer::clear()
+		{
+			m_times.clear();
+		}
+
+		void PipelinePrewarmer::getSlowest(u32 count, std::vector<PipelinePrewarmTime>* times) const
+		{
+			*times = m_times;
+
+			count = std::min(count, static_cast<u32>(times->size()));
+			std::partial_sort(times->begin(), times->begin() + count, times->end(), [](const PipelinePrewarmTime &l, const PipelinePrewarmTime &r)
+			{
+				return l.milliseconds > r.milliseconds;
+			});
+			times->resize(count);
+		}
+	}
+}
\ No newline at end of file
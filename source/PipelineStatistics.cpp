@@ -0,0 +1,234 @@
+/*
+The MIT License(MIT)
+
+Copyright(c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/PipelineStatistics.h>
+#include <vxGL/ProgramPipeline.h>
+#include <vxGL/gl.h>
+#include <cstring>
+
+namespace PipelineStatisticsCpp
+{
+	const u32 g_statisticCount = static_cast<u32>(vx::gl::PipelineStatistic::Count);
+	const u32 g_noBlock = 0xffffffff;
+
+	const u32 g_targets[g_statisticCount] =
+	{
+		GL_VERTICES_SUBMITTED_ARB,
+		GL_PRIMITIVES_SUBMITTED_ARB,
+		GL_VERTEX_SHADER_INVOCATIONS_ARB,
+		GL_TESS_CONTROL_SHADER_PATCHES_ARB,
+		GL_TESS_EVALUATION_SHADER_INVOCATIONS_ARB,
+		GL_GEOMETRY_SHADER_INVOCATIONS,
+		GL_GEOMETRY_SHADER_PRIMITIVES_EMITTED_ARB,
+		GL_FRAGMENT_SHADER_INVOCATIONS_ARB,
+		GL_COMPUTE_SHADER_INVOCATIONS_ARB,
+		GL_CLIPPING_INPUT_PRIMITIVES_ARB,
+		GL_CLIPPING_OUTPUT_PRIMITIVES_ARB
+	};
+}
+
+namespace vx
+{
+	namespace gl
+	{
+		PipelineStatisticsPool::PipelineStatisticsPool()
+			:m_queries(),
+			m_freeBlocks(),
+			m_pending(),
+			m_results(),
+			m_statistics(),
+			m_statisticCount(0),
+			m_activeBlock(PipelineStatisticsCpp::g_noBlock),
+			m_activePipeline(0)
+		{
+		}
+
+		PipelineStatisticsPool::~PipelineStatisticsPool()
+		{
+			destroy();
+		}
+
+		bool PipelineStatisticsPool::create(u32 statisticMask)
+		{
+			destroy();
+
+			if (!FLEXT_ARB_pipeline_statistics_query)
+				return false;
+
+			for (u32 i = 0; i < PipelineStatisticsCpp::g_statisticCount; ++i)
+			{
+				if ((statisticMask & (1 << i)) != 0)
+				{
+					m_statistics[m_statisticCount++] = i;
+				}
+			}
+
+			return m_statisticCount != 0;
+		}
+
+		void PipelineStatisticsPool::destroy()
+		{
+			VX_ASSERT(m_activeBlock == PipelineStatisticsCpp::g_noBlock);
+
+			if (!m_queries.empty())
+			{
+				glDeleteQueries(static_cast<s32>(m_queries.size()), m_queries.data());
+				m_queries.clear();
+			}
+
+			m_freeBlocks.clear();
+			m_pending.clear();
+			m_results.clear();
+			m_statisticCount = 0;
+		}
+
+		u32 PipelineStatisticsPool::acquireBlock()
+		{
+			if (!m_freeBlocks.empty())
+			{
+				auto block = m_freeBlocks.back();
+				m_freeBlocks.pop_back();
+				return block;
+			}
+
+			// query objects are typed, every statistic needs its own
+			auto block = static_cast<u32>(m_queries.size()) / m_statisticCount;
+			for (u32 i = 0; i < m_statisticCount; ++i)
+			{
+				u32 query = 0;
+				glCreateQueries(PipelineStatisticsCpp::g_targets[m_statistics[i]], 1, &query);
+				m_queries.push_back(query);
+			}
+
+			return block;
+		}
+
+		void PipelineStatisticsPool::begin(const ProgramPipeline &pipeline)
+		{
+			begin(pipeline.getId());
+		}
+
+		void PipelineStatisticsPool::begin(u32 pipelineId)
+		{
+			if (m_statisticCount == 0)
+				return;
+
+			VX_ASSERT(m_activeBlock == PipelineStatisticsCpp::g_noBlock);
+
+			m_activeBlock = acquireBlock();
+			m_activePipeline = pipelineId;
+
+			auto queries = &m_queries[m_activeBlock * m_statisticCount];
+			for (u32 i = 0; i < m_statisticCount; ++i)
+			{
+				glBeginQuery(PipelineStatisticsCpp::g_targets[m_statistics[i]], queries[i]);
+			}
+		}
+
+		void PipelineStatisticsPool::end()
+		{
+			if (m_activeBlock == PipelineStatisticsCpp::g_noBlock)
+				return;
+
+			for (u32 i = 0; i < m_statisticCount; ++i)
+			{
+				glEndQuery(PipelineStatisticsCpp::g_targets[m_statistics[i]]);
+			}
+
+			Scope scope;
+			scope.pipeline = m_activePipeline;
+			scope.block = m_activeBlock;
+			m_pending.push_back(scope);
+
+			m_activeBlock = PipelineStatisticsCpp::g_noBlock;
+		}
+
+		bool PipelineStatisticsPool::isAvailable(u32 block) const
+		{
+			auto queries = &m_queries[block * m_statisticCount];
+			for (u32 i = 0; i < m_statisticCount; ++i)
+			{
+				u32 available = GL_FALSE;
+				glGetQueryObjectuiv(queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+				if (available == GL_FALSE)
+					return false;
+			}
+
+			return true;
+		}
+
+		u32 PipelineStatisticsPool::update()
+		{
+			// scopes finish in submission order, stop at the first one still in flight
+			u32 count = 0;
+			while (!m_pending.empty() && isAvailable(m_pending.front().block))
+			{
+				auto scope = m_pending.front();
+				m_pending.pop_front();
+
+				auto it = m_results.find(scope.pipeline);
+				if (it == m_results.end())
+				{
+					PipelineStatisticsResult result;
+					memset(&result, 0, sizeof(result));
+					result.pipeline = scope.pipeline;
+					it = m_results.insert(u32(scope.pipeline), std::move(result));
+				}
+
+				auto queries = &m_queries[scope.block * m_statisticCount];
+				for (u32 i = 0; i < m_statisticCount; ++i)
+				{
+					u64 value = 0;
+					glGetQueryObjectui64v(queries[i], GL_QUERY_RESULT, &value);
+					it->values[m_statistics[i]] += value;
+				}
+				++it->samples;
+
+				m_freeBlocks.push_back(scope.block);
+				++count;
+			}
+
+			return count;
+		}
+
+		const PipelineStatisticsResult* PipelineStatisticsPool::getResult(u32 pipelineId) const
+		{
+			auto it = m_results.find(pipelineId);
+			if (it == m_results.end())
+				return nullptr;
+
+			return &*it;
+		}
+
+		void PipelineStatisticsPool::getResults(std::vector<PipelineStatisticsResult>* results) const
+		{
+			results->assign(m_results.begin(), m_results.end());
+		}
+
+		void PipelineStatisticsPool::clearResults()
+		{
+			m_results.clear();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,342 @@
+/*
+The MIT License(MIT)
+
+Copyright(c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/PixelConversion.h>
+#include <cmath>
+#include <cstring>
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define VX_TARGET_SSSE3
+#define VX_TARGET_F16C
+#else
+#define VX_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define VX_TARGET_F16C __attribute__((target("avx,f16c")))
+#endif
+
+namespace PixelConversionCpp
+{
+	struct CpuFeatures
+	{
+		bool ssse3;
+		bool f16c;
+
+		CpuFeatures() :ssse3(false), f16c(false)
+		{
+#ifdef _MSC_VER
+			int info[4];
+			__cpuid(info, 1);
+			ssse3 = (info[2] & (1 << 9)) != 0;
+
+			// f16c is vex encoded and needs the os to save the avx state
+			bool avx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+			f16c = avx && (info[2] & (1 << 29)) != 0;
+#else
+			__builtin_cpu_init();
+			ssse3 = __builtin_cpu_supports("ssse3") != 0;
+			f16c = __builtin_cpu_supports("avx") != 0 && __builtin_cpu_supports("f16c") != 0;
+#endif
+		}
+	};
+
+	const CpuFeatures& getCpuFeatures()
+	{
+		static const CpuFeatures features;
+		return features;
+	}
+
+	// linear to srgb for floats in [2^-13, 1], indexed by exponent and the upper 10 mantissa bits.
+	// results are within one step of the exact conversion
+	struct SRGBTable
+	{
+		enum : u32 { MinExponent = 127 - 13, Size = 13 * 1024 + 1 };
+
+		u8 values[Size];
+
+		SRGBTable()
+		{
+			for (u32 i = 0; i < Size; ++i)
+			{
+				// sample the center of each bucket
+				u32 bits = ((i + (MinExponent << 10)) << 13) | (1u << 12);
+				f32 x;
+				memcpy(&x, &bits, sizeof(x));
+				x = (x > 1.0f) ? 1.0f : x;
+
+				f32 s = (x <= 0.0031308f) ? x * 12.92f : 1.055f * powf(x, 1.0f / 2.4f) - 0.055f;
+				values[i] = static_cast<u8>(s * 255.0f + 0.5f);
+			}
+		}
+	};
+
+	const SRGBTable& getSRGBTable()
+	{
+		static const SRGBTable table;
+		return table;
+	}
+
+	void floatToHalfScalar(const f32* src, u16* dst, u64 pixelCount, u32 srcChannels, u32 dstChannels)
+	{
+		for (u64 i = 0; i < pixelCount; ++i)
+		{
+			for (u32 c = 0; c < dstChannels; ++c)
+			{
+				dst[c] = (c < srcChannels) ? vx::gl::floatToHalf(src[c]) : 0x3c00;
+			}
+			src += srcChannels;
+			dst += dstChannels;
+		}
+	}
+
+	VX_TARGET_F16C void floatToHalfF16C(const f32* src, u16* dst, u64 pixelCount, u32 srcChannels, u32 dstChannels)
+	{
+		if (srcChannels == dstChannels)
+		{
+			u64 count = pixelCount * srcChannels;
+			u64 i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				__m256 v = _mm256_loadu_ps(src + i);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+			}
+
+			floatToHalfScalar(src + i, dst + i, count - i, 1, 1);
+		}
+		else
+		{
+			// rgb to rgba, one pixel per vector
+			for (u64 i = 0; i < pixelCount; ++i)
+			{
+				__m128 v = _mm_set_ps(1.0f, src[2], src[1], src[0]);
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+				src += 3;
+				dst += 4;
+			}
+		}
+	}
+
+	void convert8Scalar(const u8* src, u8* dst, u64 pixelCount, u32 srcChannels, u32 dstChannels, bool swizzle)
+	{
+		for (u64 i = 0; i < pixelCount; ++i)
+		{
+			dst[0] = swizzle ? src[2] : src[0];
+			dst[1] = src[1];
+			dst[2] = swizzle ? src[0] : src[2];
+			if (dstChannels == 4)
+			{
+				dst[3] = (srcChannels == 4) ? src[3] : 0xff;
+			}
+			src += srcChannels;
+			dst += dstChannels;
+		}
+	}
+
+	VX_TARGET_SSSE3 void convert8SSSE3(const u8* src, u8* dst, u64 pixelCount, u32 srcChannels, u32 dstChannels, bool swizzle)
+	{
+		u64 i = 0;
+		if (srcChannels == 3 && dstChannels == 4)
+		{
+			const __m128i mask = swizzle ?
+				_mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1) :
+				_mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+			const __m128i alpha = _mm_set1_epi32(0xff000000);
+
+			// loads 16 bytes for 4 pixels, stop while 6 pixels are left so the load stays in bounds
+			for (; i + 6 <= pixelCount; i += 4)
+			{
+				__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 3));
+				v = _mm_or_si128(_mm_shuffle_epi8(v, mask), alpha);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), v);
+			}
+		}
+		else if (srcChannels == 4 && dstChannels == 4 && swizzle)
+		{
+			const __m128i mask = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+			for (; i + 4 <= pixelCount; i += 4)
+			{
+				__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_shuffle_epi8(v, mask));
+			}
+		}
+
+		convert8Scalar(src + i * srcChannels, dst + i * dstChannels, pixelCount - i, srcChannels, dstChannels, swizzle);
+	}
+
+	void floatToSRGB8(const f32* src, u8* dst, u64 pixelCount, u32 srcChannels, u32 dstChannels)
+	{
+		auto &table = getSRGBTable();
+		const __m128 minValue = _mm_set1_ps(1.0f / 8192.0f);
+		const __m128 maxValue = _mm_set1_ps(1.0f);
+		const __m128i bias = _mm_set1_epi32(PixelConversionCpp::SRGBTable::MinExponent << 10);
+
+		for (u64 i = 0; i < pixelCount; ++i)
+		{
+			__m128 v = (srcChannels == 4) ? _mm_loadu_ps(src) : _mm_set_ps(1.0f, src[2], src[1], src[0]);
+
+			// max with the nan operand second maps nan to the lower bound
+			__m128 clamped = _mm_min_ps(_mm_max_ps(v, minValue), maxValue);
+			__m128i index = _mm_sub_epi32(_mm_srli_epi32(_mm_castps_si128(clamped), 13), bias);
+			__m128i alpha = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), maxValue), _mm_set1_ps(255.0f)));
+
+			alignas(16) u32 indices[4];
+			_mm_store_si128(reinterpret_cast<__m128i*>(indices), index);
+
+			dst[0] = table.values[indices[0]];
+			dst[1] = table.values[indices[1]];
+			dst[2] = table.values[indices[2]];
+			if (dstChannels == 4)
+			{
+				dst[3] = static_cast<u8>(_mm_cvtsi128_si32(_mm_srli_si128(alpha, 12)));
+			}
+
+			src += srcChannels;
+			dst += dstChannels;
+		}
+	}
+}
+
+namespace vx
+{
+	namespace gl
+	{
+		u16 floatToHalf(f32 value)
+		{
+			u32 f;
+			memcpy(&f, &value, sizeof(f));
+
+			u16 sign = static_cast<u16>((f >> 16) & 0x8000);
+			f &= 0x7fffffff;
+
+			// overflow to infinity, keep nan
+			if (f >= 0x47800000)
+				return sign | ((f > 0x7f800000) ? 0x7e00 : 0x7c00);
+
+			// denormals, let the fpu round by adding 0.5
+			if (f < 0x38800000)
+			{
+				f32 tmp;
+				memcpy(&tmp, &f, sizeof(tmp));
+				tmp += 0.5f;
+				memcpy(&f, &tmp, sizeof(f));
+				return sign | static_cast<u16>(f - 0x3f000000);
+			}
+
+			// rebias the exponent and round to nearest even
+			u32 mantissaOdd = (f >> 13) & 1;
+			f += 0xc8000fff + mantissaOdd;
+			return sign | static_cast<u16>(f >> 13);
+		}
+
+		bool getPixelConversion(TextureFormat target, DataType srcDataType, u32 srcChannels, bool bgr, PixelConversion* conversion)
+		{
+			auto &traits = getTextureFormatTraits(target);
+			if (traits.compressed != 0 || traits.depth != 0 || traits.integer != 0)
+				return false;
+
+			if (srcChannels != traits.channels && !(srcChannels == 3 && traits.channels == 4))
+				return false;
+
+			PixelConversionKernel kernel = PixelConversionKernel::None;
+			DataType dstDataType = srcDataType;
+			u32 srcChannelSize = 1;
+			u32 dstChannelSize = 1;
+
+			if (srcDataType == DataType::Float && traits.dataType == DataType::Half_Float && !bgr)
+			{
+				kernel = PixelConversionKernel::FloatToHalf;
+				dstDataType = DataType::Half_Float;
+				srcChannelSize = 4;
+				dstChannelSize = 2;
+			}
+			else if (srcDataType == DataType::Float && traits.srgb != 0 && traits.dataType == DataType::Unsigned_Byte && srcChannels >= 3 && !bgr)
+			{
+				kernel = PixelConversionKernel::FloatToSRGB8;
+				dstDataType = DataType::Unsigned_Byte;
+				srcChannelSize = 4;
+			}
+			else if (srcDataType == DataType::Unsigned_Byte && traits.dataType == DataType::Unsigned_Byte && srcChannels >= 3)
+			{
+				bool expand = (srcChannels != traits.channels);
+				if (expand)
+					kernel = bgr ? PixelConversionKernel::ExpandSwizzle8 : PixelConversionKernel::Expand8;
+				else if (bgr)
+					kernel = PixelConversionKernel::Swizzle8;
+			}
+
+			if (kernel == PixelConversionKernel::None)
+				return false;
+
+			conversion->kernel = kernel;
+			conversion->srcChannels = static_cast<u8>(srcChannels);
+			conversion->dstChannels = traits.channels;
+			conversion->dstDataType = dstDataType;
+			conversion->srcPixelSize = srcChannels * srcChannelSize;
+			conversion->dstPixelSize = traits.channels * dstChannelSize;
+
+			return true;
+		}
+
+		void convertPixels(const PixelConversion &conversion, const void* src, void* dst, u64 pixelCount)
+		{
+			auto &features = PixelConversionCpp::getCpuFeatures();
+			u32 srcChannels = conversion.srcChannels;
+			u32 dstChannels = conversion.dstChannels;
+
+			switch (conversion.kernel)
+			{
+			case PixelConversionKernel::FloatToHalf:
+			{
+				auto srcFloat = static_cast<const f32*>(src);
+				auto dstHalf = static_cast<u16*>(dst);
+				if (features.f16c)
+					PixelConversionCpp::floatToHalfF16C(srcFloat, dstHalf, pixelCount, srcChannels, dstChannels);
+				else
+					PixelConversionCpp::floatToHalfScalar(srcFloat, dstHalf, pixelCount, srcChannels, dstChannels);
+			}break;
+			case PixelConversionKernel::Expand8:
+			case PixelConversionKernel::Swizzle8:
+			case PixelConversionKernel::ExpandSwizzle8:
+			{
+				bool swizzle = (conversion.kernel != PixelConversionKernel::Expand8);
+				auto srcBytes = static_cast<const u8*>(src);
+				auto dstBytes = static_cast<u8*>(dst);
+				if (features.ssse3)
+					PixelConversionCpp::convert8SSSE3(srcBytes, dstBytes, pixelCount, srcChannels, dstChannels, swizzle);
+				else
+					PixelConversionCpp::convert8Scalar(srcBytes, dstBytes, pixelCount, srcChannels, dstChannels, swizzle);
+			}break;
+			case PixelConversionKernel::FloatToSRGB8:
+				PixelConversionCpp::floatToSRGB8(static_cast<const f32*>(src), static_cast<u8*>(dst), pixelCount, srcChannels, dstChannels);
+				break;
+			default:
+				VX_ASSERT(false);
+				break;
+			}
+		}
+	}
+}
\ No newline at end of file
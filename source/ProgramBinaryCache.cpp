@@ -0,0 +1,138 @@
+/*
+The MIT License(MIT)
+
+Copyright(c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/ProgramBinaryCache.h>
+#include <vxGL/CacheFile.h>
+#include <vxGL/ShaderProgram.h>
+#include <vxGL/gl.h>
+#include <Windows.h>
+#include <cstdio>
+#include <cstring>
+
+namespace ProgramBinaryCacheCpp
+{
+	const u32 g_magic = 0x42505856; // 'VXPB'
+	const u32 g_version = 2;
+
+	u64 hashString(const char* str, u64 value)
+	{
+		return str ? vx::gl::hashFnv1a(str, strlen(str), value) : value;
+	}
+}
+
+namespace vx
+{
+	namespace gl
+	{
+		ProgramBinaryCache::ProgramBinaryCache()
+			:m_directory(),
+			m_contextHash(0),
+			m_enabled(false)
+		{
+		}
+
+		ProgramBinaryCache::~ProgramBinaryCache()
+		{
+		}
+
+		void ProgramBinaryCache::initialize(const std::string &directory)
+		{
+			m_directory = directory;
+
+			s32 formatCount = 0;
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+			m_enabled = (formatCount > 0);
+			if (!m_enabled)
+				return;
+
+			CreateDirectoryA(m_directory.c_str(), nullptr);
+
+			auto contextHash = hashFnv1a(&ProgramBinaryCacheCpp::g_version, sizeof(u32));
+			contextHash = ProgramBinaryCacheCpp::hashString(reinterpret_cast<const char*>(glGetString(GL_VENDOR)), contextHash);
+			contextHash = ProgramBinaryCacheCpp::hashString(reinterpret_cast<const char*>(glGetString(GL_RENDERER)), contextHash);
+			contextHash = ProgramBinaryCacheCpp::hashString(reinterpret_cast<const char*>(glGetString(GL_VERSION)), contextHash);
+			m_contextHash = contextHash;
+		}
+
+		std::string ProgramBinaryCache::getFileName(u64 key) const
+		{
+			char buffer[32];
+			snprintf(buffer, sizeof(buffer), "%016llx.bin", static_cast<unsigned long long>(key));
+
+			return m_directory + buffer;
+		}
+
+		u64 ProgramBinaryCache::getKey(const char* source, u64 sourceSize, ShaderProgramType type) const
+		{
+			auto key = hashFnv1a(&type, sizeof(type), m_contextHash);
+			return hashFnv1a(source, sourceSize, key);
+		}
+
+		bool ProgramBinaryCache::load(u64 key, ShaderProgram* program) const
+		{
+			if (!m_enabled)
+				return false;
+
+			// the binary format is stored in front of the binary
+			std::string data;
+			if (!readCacheFile(getFileName(key), ProgramBinaryCacheCpp::g_magic, ProgramBinaryCacheCpp::g_version, key, &data))
+				return false;
+
+			if (data.size() <= sizeof(u32))
+				return false;
+
+			u32 binaryFormat = 0;
+			memcpy(&binaryFormat, data.data(), sizeof(u32));
+
+			return program->createFromBinary(binaryFormat, data.data() + sizeof(u32), static_cast<s32>(data.size() - sizeof(u32)));
+		}
+
+		bool ProgramBinaryCache::store(u64 key, const ShaderProgram &program) const
+		{
+			if (!m_enabled)
+				return false;
+
+			u32 binaryFormat = 0;
+			s32 binarySize = 0;
+			auto binary = program.getBinary(&binaryFormat, &binarySize);
+			if (!binary)
+				return false;
+
+			std::string data;
+			data.reserve(sizeof(u32) + binarySize);
+			data.append(reinterpret_cast<const char*>(&binaryFormat), sizeof(u32));
+			data.append(reinterpret_cast<const char*>(binary.get()), binarySize);
+
+			return writeCacheFile(getFileName(key), ProgramBinaryCacheCpp::g_magic, ProgramBinaryCacheCpp::g_version, key, data.data(), data.size());
+		}
+
+		void ProgramBinaryCache::remove(u64 key) const
+		{
+			if (m_enabled)
+			{
+				DeleteFileA(getFileName(key).c_str());
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,206 @@
+/*
+The MIT License(MIT)
+
+Copyright(c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/ProgramReflection.h>
+#include <vxGL/gl.h>
+#include <algorithm>
+#include <vector>
+
+namespace ProgramReflectionCpp
+{
+	bool isSampler(u32 type)
+	{
+		return (type >= GL_SAMPLER_1D && type <= GL_SAMPLER_2D_RECT_SHADOW) ||
+			(type >= GL_SAMPLER_1D_ARRAY && type <= GL_SAMPLER_CUBE_SHADOW) ||
+			(type >= GL_INT_SAMPLER_1D && type <= GL_UNSIGNED_INT_SAMPLER_BUFFER) ||
+			(type >= GL_SAMPLER_CUBE_MAP_ARRAY && type <= GL_UNSIGNED_INT_SAMPLER_CUBE_MAP_ARRAY) ||
+			(type >= GL_SAMPLER_2D_MULTISAMPLE && type <= GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE_ARRAY);
+	}
+
+	bool isImage(u32 type)
+	{
+		return (type >= GL_IMAGE_1D && type <= GL_UNSIGNED_INT_IMAGE_2D_MULTISAMPLE_ARRAY);
+	}
+
+	vx::StringID getSid(char* name, s32 length)
+	{
+		// arrays are reported as name[0]
+		if (length > 3 && strcmp(name + length - 3, "[0]") == 0)
+		{
+			name[length - 3] = '\0';
+		}
+
+		return vx::make_sid(name);
+	}
+
+	s32 getMaxNameLength(u32 programId, u32 programInterface)
+	{
+		s32 size = 0;
+		glGetProgramInterfaceiv(programId, programInterface, GL_MAX_NAME_LENGTH, &size);
+		return size;
+	}
+}
+
+namespace vx
+{
+	namespace gl
+	{
+		ProgramReflection::ProgramReflection()
+			:m_resources()
+		{
+		}
+
+		ProgramReflection::ProgramReflection(ProgramReflection &&rhs) noexcept
+			:m_resources(std::move(rhs.m_resources))
+		{
+		}
+
+		ProgramReflection::~ProgramReflection()
+		{
+		}
+
+		ProgramReflection& ProgramReflection::operator=(ProgramReflection &&rhs) noexcept
+		{
+			if (this != &rhs)
+			{
+				std::swap(m_resources, rhs.m_resources);
+			}
+
+			return *this;
+		}
+
+		void ProgramReflection::create(u32 programId)
+		{
+			m_resources.clear();
+
+			s32 nameSize = ProgramReflectionCpp::getMaxNameLength(programId, GL_UNIFORM);
+			nameSize = std::max(nameSize, ProgramReflectionCpp::getMaxNameLength(programId, GL_UNIFORM_BLOCK));
+			nameSize = std::max(nameSize, ProgramReflectionCpp::getMaxNameLength(programId, GL_SHADER_STORAGE_BLOCK));
+			if (nameSize == 0)
+				return;
+
+			std::vector<char> name(nameSize + 1);
+			addUniforms(programId, name.data(), nameSize);
+			addBlocks(programId, GL_UNIFORM_BLOCK, ProgramResourceType::UniformBlock, name.data(), nameSize);
+			addBlocks(programId, GL_SHADER_STORAGE_BLOCK, ProgramResourceType::ShaderStorageBlock, name.data(), nameSize);
+		}
+
+		void ProgramReflection::addUniforms(u32 programId, char* name, s32 nameSize)
+		{
+			s32 count = 0;
+			glGetProgramInterfaceiv(programId, GL_UNIFORM, GL_ACTIVE_RESOURCES, &count);
+
+			const GLenum properties[] = { GL_TYPE, GL_LOCATION, GL_OFFSET, GL_ARRAY_SIZE, GL_BLOCK_INDEX };
+			const s32 propertyCount = sizeof(properties) / sizeof(properties[0]);
+
+			m_resources.reserve(m_resources.size() + count);
+			for (s32 i = 0; i < count; ++i)
+			{
+				s32 values[propertyCount];
+				glGetProgramResourceiv(programId, GL_UNIFORM, i, propertyCount, properties, propertyCount, nullptr, values);
+
+				s32 length = 0;
+				glGetProgramResourceName(programId, GL_UNIFORM, i, nameSize, &length, name);
+				auto sid = ProgramReflectionCpp::getSid(name, length);
+				if (m_resources.find(sid))
+					continue;
+
+				ProgramResource resource;
+				resource.glType = values[0];
+				resource.location = values[1];
+				resource.offset = values[2];
+				resource.size = values[3];
+				resource.blockIndex = values[4];
+				resource.binding = -1;
+				resource.type = ProgramResourceType::Uniform;
+
+				if (ProgramReflectionCpp::isSampler(resource.glType))
+				{
+					resource.type = ProgramResourceType::Sampler;
+				}
+				else if (ProgramReflectionCpp::isImage(resource.glType))
+				{
+					resource.type = ProgramResourceType::Image;
+				}
+
+				// the unit of samplers and images is the value of the uniform
+				if (resource.type != ProgramResourceType::Uniform && resource.location >= 0)
+				{
+					glGetUniformiv(programId, resource.location, &resource.binding);
+				}
+
+				m_resources.insert(sid, std::move(resource));
+			}
+		}
+
+		void ProgramReflection::addBlocks(u32 programId, u32 programInterface, ProgramResourceType type, char* name, s32 nameSize)
+		{
+			s32 count = 0;
+			glGetProgramInterfaceiv(programId, programInterface, GL_ACTIVE_RESOURCES, &count);
+
+			const GLenum properties[] = { GL_BUFFER_BINDING, GL_BUFFER_DATA_SIZE };
+			const s32 propertyCount = sizeof(properties) / sizeof(properties[0]);
+
+			for (s32 i = 0; i < count; ++i)
+			{
+				s32 values[propertyCount];
+				glGetProgramResourceiv(programId, programInterface, i, propertyCount, properties, propertyCount, nullptr, values);
+
+				s32 length = 0;
+				glGetProgramResourceName(programId, programInterface, i, nameSize, &length, name);
+				auto sid = ProgramReflectionCpp::getSid(name, length);
+				if (m_resources.find(sid))
+					continue;
+
+				ProgramResource resource;
+				resource.location = -1;
+				resource.offset = -1;
+				resource.size = values[1];
+				resource.binding = values[0];
+				resource.blockIndex = i;
+				resource.glType = 0;
+				resource.type = type;
+
+				m_resources.insert(sid, std::move(resource));
+			}
+		}
+
+		void ProgramReflection::clear()
+		{
+			m_resources.clear();
+		}
+
+		s32 ProgramReflection::getUniformLocation(const vx::StringID &sid) const
+		{
+			auto resource = m_resources.find(sid);
+			return resource ? resource->location : -1;
+		}
+
+		s32 ProgramReflection::getBinding(const vx::StringID &sid) const
+		{
+			auto resource = m_resources.find(sid);
+			return resource ? resource->binding : -1;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,215 @@
+/*
+The MIT License(MIT)
+
+Copyright(c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/RenderTargetPool.h>
+
+namespace vx
+{
+	namespace gl
+	{
+		RenderTargetPool::RenderTargetPool(u32 frameLifetime)
+			:m_buckets(),
+			m_entries(),
+			m_textures(),
+			m_frame(0),
+			m_frameLifetime(frameLifetime)
+		{
+		}
+
+		RenderTargetPool::~RenderTargetPool()
+		{
+		}
+
+		u64 RenderTargetPool::DescriptionKey::hash(const TextureDescription &desc)
+		{
+			// fnv-1a over the fields that affect storage
+			const u64 prime = 1099511628211ull;
+			u64 hash = 14695981039346656037ull;
+
+			const u32 values[] =
+			{
+				desc.size.x, desc.size.y, desc.size.z, desc.miplevels,
+				(u32)desc.type, (u32)desc.format, desc.fixedsamplelocations, desc.sparse
+			};
+
+			for (auto value : values)
+			{
+				hash ^= value;
+				hash *= prime;
+			}
+
+			return hash;
+		}
+
+		bool RenderTargetPool::DescriptionKey::isEqual(const TextureDescription &l, const TextureDescription &r)
+		{
+			return l.size.x == r.size.x &&
+				l.size.y == r.size.y &&
+				l.size.z == r.size.z &&
+				l.miplevels == r.miplevels &&
+				l.type == r.type &&
+				l.format == r.format &&
+				l.fixedsamplelocations == r.fixedsamplelocations &&
+				l.sparse == r.sparse;
+		}
+
+		const Texture* RenderTargetPool::acquire(const TextureDescription &desc)
+		{
+			auto bucketIndex = m_buckets.getHandle(desc);
+			if (bucketIndex != m_buckets.s_invalidHandle)
+			{
+				auto &freeEntries = m_buckets[bucketIndex].freeEntries;
+				if (!freeEntries.empty())
+				{
+					auto index = freeEntries.back();
+					freeEntries.pop_back();
+
+					auto &entry = m_entries[index];
+					entry.inUse = 1;
+					entry.lastUsedFrame = m_frame;
+					return m_textures[index].get();
+				}
+			}
+
+			auto texture = std::unique_ptr<PooledTexture>(new PooledTexture());
+			texture->create(desc);
+			if (!texture->isValid())
+				return nullptr;
+
+			if (bucketIndex == m_buckets.s_invalidHandle)
+			{
+				bucketIndex = m_buckets.insert(desc, Bucket());
+			}
+
+			Entry entry;
+			entry.bucket = bucketIndex;
+			entry.lastUsedFrame = m_frame;
+			entry.inUse = 1;
+
+			texture->entry = static_cast<u32>(m_entries.size());
+			m_entries.push_back(entry);
+			m_textures.push_back(std::move(texture));
+
+			return m_textures.back().get();
+		}
+
+		void RenderTargetPool::release(const Texture* texture)
+		{
+			// only textures handed out by acquire() may be released
+			auto index = static_cast<const PooledTexture*>(texture)->entry;
+			VX_ASSERT(index < m_textures.size() && m_textures[index].get() == texture);
+
+			auto &entry = m_entries[index];
+			if (entry.inUse != 0)
+			{
+				entry.inUse = 0;
+				m_buckets[entry.bucket].freeEntries.push_back(index);
+			}
+		}
+
+		void RenderTargetPool::endFrame()
+		{
+			u32 i = 0;
+			while (i < m_entries.size())
+			{
+				auto &entry = m_entries[i];
+				entry.inUse = 0;
+
+				if (m_frame - entry.lastUsedFrame >= m_frameLifetime)
+				{
+					eraseEntry(i);
+				}
+				else
+				{
+					++i;
+				}
+			}
+
+			// erasing moves entries, so the free lists are rebuilt from scratch
+			for (auto &it : m_buckets)
+			{
+				it.freeEntries.clear();
+			}
+
+			auto count = static_cast<u32>(m_entries.size());
+			for (i = 0; i < count; ++i)
+			{
+				m_buckets[m_entries[i].bucket].freeEntries.push_back(i);
+			}
+
+			// drop buckets without textures, erase moves the last bucket into the hole.
+			// Walking backwards means the moved bucket was already kept, so only its entries need the new index
+			i = m_buckets.size();
+			while (i != 0)
+			{
+				--i;
+				if (!m_buckets[i].freeEntries.empty())
+					continue;
+
+				m_buckets.erase(i);
+				if (i < m_buckets.size())
+				{
+					for (auto index : m_buckets[i].freeEntries)
+					{
+						m_entries[index].bucket = i;
+					}
+				}
+			}
+
+			++m_frame;
+		}
+
+		void RenderTargetPool::clear()
+		{
+			m_buckets.clear();
+			m_entries.clear();
+			m_textures.clear();
+		}
+
+		u64 RenderTargetPool::getMemoryUsage() const
+		{
+			u64 size = 0;
+			for (auto &texture : m_textures)
+			{
+				size += texture->getMemorySize();
+			}
+
+			return size;
+		}
+
+		void RenderTargetPool::eraseEntry(u32 index)
+		{
+			auto last = m_entries.size() - 1;
+			if (index != last)
+			{
+				m_entries[index] = m_entries[last];
+				std::swap(m_textures[index], m_textures[last]);
+				m_textures[index]->entry = index;
+			}
+
+			m_entries.pop_back();
+			m_textures.pop_back();
+		}
+	}
+}
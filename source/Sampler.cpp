@@ -0,0 +1,133 @@
+/*
+The MIT License(MIT)
+
+Copyright(c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/Sampler.h>
+#include <vxGL/gl.h>
+#include <algorithm>
+
+// the extension is not part of flextGL
+#ifndef GL_TEXTURE_MAX_ANISOTROPY_EXT
+#define GL_TEXTURE_MAX_ANISOTROPY_EXT 0x84FE
+#endif
+
+namespace vx
+{
+	namespace gl
+	{
+		SamplerDescription getCanonicalSamplerDescription(const SamplerDescription &desc)
+		{
+			SamplerDescription result = desc;
+
+			// -0.0 and 0.0 have different bit patterns
+			if (result.lodBias == 0.0f)
+			{
+				result.lodBias = 0.0f;
+			}
+
+			result.maxAnisotropy = (result.maxAnisotropy > 1) ? std::min(result.maxAnisotropy, (u8)16) : 0;
+
+			if (result.compare == 0)
+			{
+				result.compareFunc = TextureCompareFunc::Lequal;
+			}
+			else
+			{
+				result.compare = 1;
+			}
+
+			return result;
+		}
+
+		Sampler::Sampler()
+			:Base()
+		{
+		}
+
+		Sampler::Sampler(Sampler &&rhs) noexcept
+			: Base(std::move(rhs))
+		{
+		}
+
+		Sampler::~Sampler()
+		{
+		}
+
+		Sampler& Sampler::operator=(Sampler &&rhs) noexcept
+		{
+			Base::operator=(std::move(rhs));
+			return *this;
+		}
+
+		void Sampler::create(const SamplerDescription &description)
+		{
+			if (m_id == 0)
+			{
+				auto desc = getCanonicalSamplerDescription(description);
+
+				glCreateSamplers(1, &m_id);
+
+				glSamplerParameteri(m_id, GL_TEXTURE_MIN_FILTER, detail::getTextureFilter(desc.minFilter));
+				glSamplerParameteri(m_id, GL_TEXTURE_MAG_FILTER, detail::getTextureFilter(desc.magFilter));
+				glSamplerParameteri(m_id, GL_TEXTURE_WRAP_S, detail::getTextureWrapMode(desc.wrapS));
+				glSamplerParameteri(m_id, GL_TEXTURE_WRAP_T, detail::getTextureWrapMode(desc.wrapT));
+				glSamplerParameteri(m_id, GL_TEXTURE_WRAP_R, detail::getTextureWrapMode(desc.wrapR));
+
+				if (desc.lodBias != 0.0f)
+				{
+					glSamplerParameterf(m_id, GL_TEXTURE_LOD_BIAS, desc.lodBias);
+				}
+
+				if (desc.maxAnisotropy > 1)
+				{
+					glSamplerParameterf(m_id, GL_TEXTURE_MAX_ANISOTROPY_EXT, (f32)desc.maxAnisotropy);
+				}
+
+				if (desc.compare != 0)
+				{
+					glSamplerParameteri(m_id, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+					glSamplerParameteri(m_id, GL_TEXTURE_COMPARE_FUNC, (u32)desc.compareFunc);
+				}
+			}
+		}
+
+		void Sampler::destroy()
+		{
+			if (m_id != 0)
+			{
+				glDeleteSamplers(1, &m_id);
+				m_id = 0;
+			}
+		}
+
+		void Sampler::bind(u32 unit) const
+		{
+			glBindSampler(unit, m_id);
+		}
+
+		void Sampler::bindZero(u32 unit) const
+		{
+			glBindSampler(unit, 0);
+		}
+	}
+}
@@ -0,0 +1,93 @@
+/*
+The MIT License(MIT)
+
+Copyright(c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/SamplerCache.h>
+#include <vxGL/gl.h>
+#include <cstring>
+
+namespace vx
+{
+	namespace gl
+	{
+		SamplerCache::SamplerCache()
+			:m_samplers()
+		{
+		}
+
+		SamplerCache::~SamplerCache()
+		{
+		}
+
+		u64 SamplerCache::getKey(const SamplerDescription &desc)
+		{
+			// expects a canonical description, the whole state fits into 54 bits, so equal keys always mean equal samplers
+			u32 lodBias;
+			memcpy(&lodBias, &desc.lodBias, sizeof(lodBias));
+
+			u64 key = lodBias;
+			key |= (u64)((u32)desc.minFilter & 0x3) << 32;
+			key |= (u64)((u32)desc.magFilter & 0x3) << 34;
+			key |= (u64)((u32)desc.wrapS & 0x7) << 36;
+			key |= (u64)((u32)desc.wrapT & 0x7) << 39;
+			key |= (u64)((u32)desc.wrapR & 0x7) << 42;
+			key |= (u64)(desc.maxAnisotropy & 0x1f) << 45;
+			key |= (u64)(desc.compare & 0x1) << 50;
+			key |= (u64)((u32)desc.compareFunc & 0x7) << 51;
+
+			return key;
+		}
+
+		u32 SamplerCache::getSampler(const SamplerDescription &desc)
+		{
+			auto canonical = getCanonicalSamplerDescription(desc);
+			auto key = getKey(canonical);
+
+			auto it = m_samplers.find(key);
+			if (it == m_samplers.end())
+			{
+				Sampler sampler;
+				sampler.create(canonical);
+
+				it = m_samplers.insert(std::move(key), std::move(sampler));
+			}
+
+			return it->getId();
+		}
+
+		void SamplerCache::clear()
+		{
+			m_samplers.clear();
+		}
+
+		void SamplerCache::bind(u32 unit, u32 sampler)
+		{
+			glBindSampler(unit, sampler);
+		}
+
+		void SamplerCache::bind(u32 firstUnit, u32 count, const u32* samplers)
+		{
+			glBindSamplers(firstUnit, count, samplers);
+		}
+	}
+}
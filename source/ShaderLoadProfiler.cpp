@@ -0,0 +1,235 @@
+/*
+The MIT License(MIT)
+
+Copyright(c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/ShaderLoadProfiler.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace ShaderLoadProfilerCpp
+{
+	const u32 g_phaseCount = static_cast<u32>(vx::gl::ShaderLoadPhase::Count);
+
+	u64 getMicroseconds()
+	{
+		auto time = std::chrono::high_resolution_clock::now().time_since_epoch();
+		return std::chrono::duration_cast<std::chrono::microseconds>(time).count();
+	}
+
+	void writeJsonString(FILE* file, const std::string &str)
+	{
+		fputc('"', file);
+		for (auto c : str)
+		{
+			if (c == '"' || c == '\\')
+				fputc('\\', file);
+
+			fputc(c, file);
+		}
+		fputc('"', file);
+	}
+}
+
+namespace vx
+{
+	namespace gl
+	{
+		ShaderLoadProfiler::ShaderLoadProfiler()
+			:m_events(),
+			m_names(),
+			m_nameIndices(),
+			m_origin(0),
+			m_enabled(false)
+		{
+		}
+
+		ShaderLoadProfiler::~ShaderLoadProfiler()
+		{
+		}
+
+		void ShaderLoadProfiler::enable(bool enable)
+		{
+			if (enable && !m_enabled)
+			{
+				m_origin = ShaderLoadProfilerCpp::getMicroseconds();
+			}
+
+			m_enabled = enable;
+		}
+
+		void ShaderLoadProfiler::clear()
+		{
+			m_events.clear();
+			m_names.clear();
+			m_nameIndices.clear();
+			m_origin = ShaderLoadProfilerCpp::getMicroseconds();
+		}
+
+		u64 ShaderLoadProfiler::now() const
+		{
+			return ShaderLoadProfilerCpp::getMicroseconds() - m_origin;
+		}
+
+		u32 ShaderLoadProfiler::getNameIndex(const std::string &name)
+		{
+			auto sid = vx::make_sid(name.c_str());
+			auto index = m_nameIndices.find(sid);
+			if (index)
+				return *index;
+
+			u32 newIndex = static_cast<u32>(m_names.size());
+			m_names.push_back(name);
+			m_nameIndices.insert(sid, u32(newIndex));
+
+			return newIndex;
+		}
+
+		void ShaderLoadProfiler::addEvent(const std::string &name, ShaderLoadPhase phase, u64 start, u64 end)
+		{
+			Event event;
+			event.nameIndex = getNameIndex(name);
+			event.phase = phase;
+			event.start = start;
+			event.duration = end - start;
+			m_events.push_back(event);
+		}
+
+		void ShaderLoadProfiler::getTimings(std::vector<ShaderLoadTiming>* timings) const
+		{
+			timings->clear();
+			timings->resize(m_names.size());
+
+			for (u32 i = 0; i < m_names.size(); ++i)
+			{
+				auto &timing = (*timings)[i];
+				timing.name = m_names[i];
+				std::fill(timing.milliseconds, timing.milliseconds + ShaderLoadProfilerCpp::g_phaseCount, 0.0f);
+				timing.total = 0.0f;
+			}
+
+			for (auto &it : m_events)
+			{
+				auto milliseconds = it.duration * 0.001f;
+
+				auto &timing = (*timings)[it.nameIndex];
+				timing.milliseconds[static_cast<u32>(it.phase)] += milliseconds;
+				timing.total += milliseconds;
+			}
+
+			std::sort(timings->begin(), timings->end(), [](const ShaderLoadTiming &l, const ShaderLoadTiming &r)
+			{
+				return l.total > r.total;
+			});
+		}
+
+		f32 ShaderLoadProfiler::getPhaseTotal(ShaderLoadPhase phase) const
+		{
+			u64 total = 0;
+			for (auto &it : m_events)
+			{
+				if (it.phase == phase)
+					total += it.duration;
+			}
+
+			return total * 0.001f;
+		}
+
+		bool ShaderLoadProfiler::writeReport(const char* file) const
+		{
+			FILE* outFile = fopen(file, "w");
+			if (!outFile)
+				return false;
+
+			fprintf(outFile, "phase totals (ms)\n");
+			for (u32 i = 0; i < ShaderLoadProfilerCpp::g_phaseCount; ++i)
+			{
+				auto phase = static_cast<ShaderLoadPhase>(i);
+				fprintf(outFile, "%-18s %10.3f\n", getPhaseName(phase), getPhaseTotal(phase));
+			}
+
+			fprintf(outFile, "\n%10s", "total");
+			for (u32 i = 0; i < ShaderLoadProfilerCpp::g_phaseCount; ++i)
+			{
+				fprintf(outFile, " %16s", getPhaseName(static_cast<ShaderLoadPhase>(i)));
+			}
+			fprintf(outFile, "  name\n");
+
+			std::vector<ShaderLoadTiming> timings;
+			getTimings(&timings);
+			for (auto &it : timings)
+			{
+				fprintf(outFile, "%10.3f", it.total);
+				for (u32 i = 0; i < ShaderLoadProfilerCpp::g_phaseCount; ++i)
+				{
+					fprintf(outFile, " %16.3f", it.milliseconds[i]);
+				}
+				fprintf(outFile, "  %s\n", it.name.c_str());
+			}
+
+			fclose(outFile);
+			return true;
+		}
+
+		bool ShaderLoadProfiler::writeChromeTrace(const char* file) const
+		{
+			FILE* outFile = fopen(file, "w");
+			if (!outFile)
+				return false;
+
+			fprintf(outFile, "{\"traceEvents\":[\n");
+			for (u32 i = 0; i < m_events.size(); ++i)
+			{
+				auto &it = m_events[i];
+
+				fprintf(outFile, "{\"name\":");
+				ShaderLoadProfilerCpp::writeJsonString(outFile, m_names[it.nameIndex]);
+				fprintf(outFile, ",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%llu,\"dur\":%llu,\"pid\":0,\"tid\":0}%s\n",
+					getPhaseName(it.phase), static_cast<unsigned long long>(it.start), static_cast<unsigned long long>(it.duration),
+					(i + 1 < m_events.size()) ? "," : "");
+			}
+			fprintf(outFile, "]}\n");
+
+			fclose(outFile);
+			return true;
+		}
+
+		const char* ShaderLoadProfiler::getPhaseName(ShaderLoadPhase phase)
+		{
+			const char* names[] =
+			{
+				"hash",
+				"file_read",
+				"preprocess",
+				"binary_cache_load",
+				"compile",
+				"link",
+				"binary_cache_store",
+				"pipeline"
+			};
+			static_assert(sizeof(names) / sizeof(names[0]) == ShaderLoadProfilerCpp::g_phaseCount, "phase names out of date");
+
+			return names[static_cast<u32>(phase)];
+		}
+	}
+}
\ No newline at end of file
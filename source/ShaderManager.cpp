@@ -23,7 +23,9 @@ SOFTWARE.
 */
 
 #include <vxGL/ShaderManager.h>
+#include <vxGL/CacheFile.h>
 #include <vxGL/ProgramPipeline.h>
+#include <vxGL/ShaderManifest.h>
 #include <vxGL/ShaderProgram.h>
 #include <Shlwapi.h>
 #include <vxGL/gl.h>
@@ -31,754 +33,1056 @@ SOFTWARE.
 #include <vxLib/File/FileHandle.h>
 #include <vxLib/Variant.h>
 #include <vxLib/ScopeGuard.h>
-#include <vxLib/Allocator/StackAllocator.h>
+#include <algorithm>
+#include <chrono>
 #include <fstream>
+#include <iterator>
 
-namespace vx
+namespace ShaderManagerCpp
 {
-	namespace gl
+	void getIncludeNames(const std::string &text, std::vector<std::string>* names)
 	{
-		enum ShaderParameterType{ Int, Uint, Float };
-
-		struct ShaderParameter
+		size_t lineBegin = 0;
+		while (lineBegin < text.size())
 		{
-			union
-			{
-				u32 u;
-				s32 s;
-				f32 f;
-			};
-
-			ShaderParameterType type;
+			auto lineEnd = text.find('\n', lineBegin);
+			if (lineEnd == std::string::npos)
+				lineEnd = text.size();
 
-			explicit ShaderParameter(u32 v) :u(v), type(ShaderParameterType::Uint){}
-			explicit ShaderParameter(s32 v) :s(v), type(ShaderParameterType::Int){}
-			explicit ShaderParameter(f32 v) :f(v), type(ShaderParameterType::Float){}
-
-			int operator()(char(&paramBuffer)[64]) const
+			auto command = text.find_first_not_of(" \t", lineBegin);
+			if (command < lineEnd && text.compare(command, 8, "#include") == 0)
 			{
-				if (type == ShaderParameterType::Int)
-				{
-					return sprintf(paramBuffer, "%d", s);
-				}
-				else if (type == ShaderParameterType::Float)
-				{
-					return sprintf(paramBuffer, "%f", f);
-				}
-				else
+				auto nameBegin = text.find_first_of("\"<", command + 8);
+				auto nameEnd = (nameBegin < lineEnd) ? text.find_first_of("\">", nameBegin + 1) : std::string::npos;
+				if (nameEnd < lineEnd)
 				{
-					return sprintf(paramBuffer, "%u", u);
+					names->push_back(text.substr(nameBegin + 1, nameEnd - nameBegin - 1));
 				}
 			}
-		};
+
+			lineBegin = lineEnd + 1;
+		}
 	}
 }
 
-namespace ShaderManagerCpp
+namespace vx
 {
-	const char* findParameter(const char* str)
+	namespace gl
 	{
-		while (true)
+		ShaderManager::ShaderManager()
+			:m_programPipelines(),
+			m_shaderPrograms(),
+			m_pendingPrograms(),
+			m_pendingPipelines(),
+			m_programSources(),
+			m_includeFiles(),
+			m_permutationSets(),
+			m_permutationIndices(),
+			m_fileWatcher(),
+			m_preprocessor(),
+			m_binaryCache(),
+			m_sourceCache(),
+			m_prewarmer(),
+			m_profiler(),
+			m_fileHashes(),
+			m_defines(),
+			m_parameters(),
+			m_stateHash(0),
+			m_prewarmedCount(0),
+			m_dataDir(),
+			m_stateHashDirty(true),
+			m_hotReload(false)
 		{
-			if (str[0] == '\0' || str[0] == '$')
-				break;
 
-			++str;
 		}
 
-		return str;
-	}
-
-	bool insertParameter(char** str, const vx::sorted_vector<vx::StringID, vx::gl::ShaderParameter> &params, vx::StackAllocator* scratchAllocator)
-	{
-		auto paramBegin = findParameter(*str);
-		auto sizeToParam = paramBegin - *str;
-		if (paramBegin[0] == '\0')
-			return false;
+		ShaderManager::~ShaderManager()
+		{
+		}
 
-		++paramBegin;
+		void ShaderManager::initialize(const std::string &dataDir, bool useBinaryCache)
+		{
+			m_dataDir = dataDir;
+			m_preprocessor.setIncludeDirectory(m_dataDir + "shaders/include/");
 
-		auto paramEnd = findParameter(paramBegin);
-		if (paramEnd[0] == '\0')
-			return false;
+			if (useBinaryCache)
+			{
+				m_binaryCache.initialize(m_dataDir + "shaders/cache/");
+				m_sourceCache.initialize(m_dataDir + "shaders/cache/");
+			}
 
-		auto paramNameSize = paramEnd - paramBegin;
-		char paramName[64] = {};
-		strncpy(paramName, paramBegin, paramNameSize);
+			if (FLEXT_KHR_parallel_shader_compile)
+			{
+				// let the driver choose the number of compiler threads
+				glMaxShaderCompilerThreadsKHR(0xffffffff);
+			}
+		}
 
-		auto it = params.find(vx::make_sid(paramName));
-		if (it == params.end())
+		void ShaderManager::clear()
 		{
-			printf("could not find value for parameter '%s'\n", paramName);
-			return false;
+			m_pendingPipelines.clear();
+			m_pendingPrograms.clear();
+			m_programPipelines.clear();
+			m_shaderPrograms.clear();
+			m_programSources.clear();
+			m_permutationIndices.clear();
+			m_permutationSets.clear();
+			m_sourceCache.clear();
+			m_fileHashes.clear();
+			m_prewarmer.clear();
+			m_prewarmedCount = 0;
 		}
 
-		++paramEnd;
+		bool ShaderManager::submitProgram(const vx::StringID &programSid, const std::string &file, vx::gl::ShaderProgramType type, const DefineOverrides &defines, std::string* error)
+		{
+			auto sid = programSid;
+			if (m_shaderPrograms.find(sid))
+				return true;
 
-		auto sizeToEnd = strlen(paramEnd);
+			for (auto &it : m_pendingPrograms)
+			{
+				if (it.sid == sid)
+					return true;
+			}
 
-		char paramBuffer[64] = {};
+			PendingProgram pending(type);
+			pending.sid = sid;
+			pending.file = file;
 
-		auto valueSize = (*it)(paramBuffer);
+			if (!createProgram(&pending, error))
+				return false;
 
-		auto bufferSize = sizeToParam + valueSize + sizeToEnd;
+			if (m_hotReload && !m_programSources.find(sid))
+			{
+				ProgramSource source;
+				source.sid = sid;
+				source.file = pending.file;
+				source.type = type;
+				source.defines = defines;
+				addDependencies(source.file, &source.dependencies);
+
+				m_programSources.insert(sid, std::move(source));
+			}
 
-		auto newText = (char*)scratchAllocator->allocate(bufferSize + 1);
-		memset(newText, 0, bufferSize + 1);
+			m_pendingPrograms.push_back(std::move(pending));
 
-		strncpy(newText, *str, sizeToParam);
-		strncpy(newText + sizeToParam, paramBuffer, valueSize);
-		strncpy(newText + sizeToParam + valueSize, paramEnd, sizeToEnd);
+			return true;
+		}
 
-		*str = newText;
+		bool ShaderManager::createProgram(PendingProgram* pending, std::string* error)
+		{
+			std::string programData;
+			if (!preprocessProgram(pending->file, &programData))
+			{
+				error->append("shader error: could not preprocess ");
+				error->append(pending->file);
+				error->push_back('\n');
+				return false;
+			}
 
-		return true;
-	}
+			bool loaded = false;
+			{
+				ShaderLoadScope scope(&m_profiler, pending->file, ShaderLoadPhase::BinaryCacheLoad);
+				pending->binaryKey = m_binaryCache.getKey(programData.c_str(), programData.size(), pending->program.getType());
+				loaded = m_binaryCache.load(pending->binaryKey, &pending->program);
+			}
 
-	/*bool loadFile(const char* str, char** buffer, u32 &size, vx::StackAllocator* scratchAllocator)
-	{
-		std::ifstream inFile(str);
+			if (!loaded)
+			{
+				ShaderLoadScope scope(&m_profiler, pending->file, ShaderLoadPhase::Compile);
+				const char* ptr = programData.c_str();
+				if (!pending->program.submit(&ptr))
+				{
+					error->append("shader error: could not create program ");
+					error->append(pending->file);
+					error->push_back('\n');
+					return false;
+				}
 
-		if (!inFile.is_open())
-		{
-			printf("could not open file %s\n", str);
-			return false;
+				pending->source = std::move(programData);
+			}
+
+			return true;
 		}
 
-		inFile.seekg(0, std::ios::end);
-		size = inFile.tellg();
-		inFile.seekg(0, std::ios::beg);
+		bool ShaderManager::finishProgram(PendingProgram* pending, std::string* error)
+		{
+			// programs from the binary cache are already linked
+			if (pending->source.empty())
+				return true;
 
-		*buffer = (char*)scratchAllocator->allocate(size);
-		memset(*buffer, 0, size);
+			s32 logSize = 0;
+			std::unique_ptr<char[]> log;
+			{
+				ShaderLoadScope scope(&m_profiler, pending->file, ShaderLoadPhase::Link);
+				log = pending->program.finish(logSize);
+			}
 
-		inFile.read(*buffer, size);
+			if (log)
+			{
+				error->append("shader error: ");
+				error->append(pending->file);
+				error->push_back('\n');
 
-		return true;
-	}*/
+				error->append(log.get());
 
-	const char* getInclude(const char* text)
-	{
-		while (true)
-		{
-			auto c = text[0];
+				auto fileName = pending->file.c_str() + pending->file.find_last_of('/') + 1;
 
-			if (c == '\0' || c == '"')
-				break;
+				std::string errorFile("error_");
+				errorFile.append(fileName);
+				std::ofstream outFile(errorFile);
+				outFile << pending->source;
 
-			++text;
-		}
+				return false;
+			}
 
-		return text;
-	}
+			ShaderLoadScope scope(&m_profiler, pending->file, ShaderLoadPhase::BinaryCacheStore);
+			m_binaryCache.store(pending->binaryKey, pending->program);
 
-	const char* getPreprocessorCommandEnd(const char* text)
-	{
-		while (true)
+			return true;
+		}
+
+		void ShaderManager::addDependencies(const std::string &file, std::vector<u32>* dependencies)
 		{
-			auto c = text[0];
+			auto index = m_fileWatcher.addFile(file);
+			for (auto it : *dependencies)
+			{
+				if (it == index)
+					return;
+			}
+			dependencies->push_back(index);
 
-			if (c == '\0' || c == ' ' || c == '\n')
-				break;
+			std::ifstream inFile(file.c_str());
+			if (!inFile.is_open())
+				return;
 
-			++text;
-		}
+			std::string text((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
 
-		return text;
-	}
+			std::vector<std::string> includes;
+			ShaderManagerCpp::getIncludeNames(text, &includes);
+			for (auto &it : includes)
+			{
+				addDependencies(resolveInclude(it), dependencies);
+			}
+		}
 
-	const char* getPreprocessorCommand(const char* text)
-	{
-		while (true)
+		std::string ShaderManager::resolveInclude(const std::string &name) const
 		{
-			auto c = text[0];
-
-			if (c == '\0' || c == '#')
-				break;
+			// includes are either registered with addIncludeFile or live in the include directory
+			for (auto &it : m_includeFiles)
+			{
+				if (it.key == name)
+					return it.file;
+			}
 
-			++text;
+			return m_dataDir + "shaders/include/" + name;
 		}
 
-		return text;
-	}
-
-	const char* getElseOrEndif(const char* text)
-	{
-		int layer = 0;
-		std::string buffer;
-		while (true)
+		u64 ShaderManager::getFileHash(const std::string &file, std::string* fileText)
 		{
-			auto command = getPreprocessorCommand(text);
-			if (command[0] == '\0')
-				break;
+			auto sid = vx::make_sid(file.c_str());
+			auto it = m_fileHashes.find(sid);
+			if (it != m_fileHashes.end())
+				return *it;
 
-			auto commandEnd = getPreprocessorCommandEnd(command);
+			// placeholder so include cycles terminate
+			m_fileHashes.insert(vx::StringID(sid), u64(0));
 
-			buffer.clear();
-			buffer.assign(command, commandEnd);
+			std::ifstream inFile(file.c_str(), std::ios::binary);
+			std::string text((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
 
-			text = commandEnd;
-			if (strcmp(buffer.c_str(), "#if") == 0)
-			{
-				++layer;
-			}
-			else if (strcmp(buffer.c_str(), "#ifdef") == 0)
+			auto value = hashFnv1a(text.data(), text.size());
+
+			std::vector<std::string> includes;
+			ShaderManagerCpp::getIncludeNames(text, &includes);
+			for (auto &include : includes)
 			{
-				++layer;
+				auto includeHash = getFileHash(resolveInclude(include), nullptr);
+				value = hashFnv1a(&includeHash, sizeof(includeHash), value);
 			}
-			else if (strcmp(buffer.c_str(), "#ifndef") == 0)
+
+			*m_fileHashes.find(sid) = value;
+
+			if (fileText)
 			{
-				++layer;
+				fileText->swap(text);
 			}
-			else if (strcmp(buffer.c_str(), "#else") == 0)
+
+			return value;
+		}
+
+		u64 ShaderManager::getStateHash()
+		{
+			if (m_stateHashDirty)
 			{
-				if (layer == 0)
+				auto defines = m_defines;
+				auto parameters = m_parameters;
+				std::sort(defines.begin(), defines.end());
+				std::sort(parameters.begin(), parameters.end());
+
+				u64 value = hashFnv1a(nullptr, 0);
+				for (auto &it : defines)
 				{
-					break;
+					value = hashFnv1a(it.c_str(), it.size() + 1, value);
 				}
-			}
-			else if (strcmp(buffer.c_str(), "#endif") == 0)
-			{
-				if (layer == 0)
+
+				value = hashFnv1a("$", 1, value);
+				for (auto &it : parameters)
 				{
-					break;
+					value = hashFnv1a(it.c_str(), it.size() + 1, value);
 				}
-				--layer;
+
+				m_stateHash = value;
+				m_stateHashDirty = false;
 			}
-		}
 
-		return text;
-	}
+			return m_stateHash;
+		}
 
-	const char* getNextLine(const char* text)
-	{
-		while (true)
+		void ShaderManager::setParameter(const char* id, const char* value)
 		{
-			auto c = text[0];
+			m_preprocessor.setParameter(id, value);
 
-			if (c == '\0' || c == '\n')
-				break;
+			std::string parameter(id);
+			parameter.push_back('=');
 
-			++text;
+			auto prefixSize = parameter.size();
+			parameter.append(value);
+
+			m_stateHashDirty = true;
+			for (auto &it : m_parameters)
+			{
+				if (it.compare(0, prefixSize, parameter, 0, prefixSize) == 0)
+				{
+					it = std::move(parameter);
+					return;
+				}
+			}
+
+			m_parameters.push_back(std::move(parameter));
 		}
 
-		return text;
-	}
+		bool ShaderManager::preprocessProgram(const std::string &file, std::string* source)
+		{
+			u64 key = 0;
+			std::string text;
+			{
+				ShaderLoadScope scope(&m_profiler, file, ShaderLoadPhase::Hash);
+				key = getFileHash(file, &text);
+				auto stateHash = getStateHash();
+				key = hashFnv1a(&stateHash, sizeof(stateHash), key);
 
-	const char* getCommandValue(const char* ptr, std::string* commandValue)
-	{
-		auto valueStart = ptr + 1;
-		auto valueEnd = getPreprocessorCommandEnd(valueStart);
+				if (m_sourceCache.find(key, source))
+					return true;
+			}
 
-		commandValue->clear();
-		commandValue->assign(valueStart, valueEnd);
+			// the text is only returned when the hash was not cached yet
+			if (text.empty())
+			{
+				ShaderLoadScope scope(&m_profiler, file, ShaderLoadPhase::FileRead);
+				std::ifstream inFile(file.c_str(), std::ios::binary);
+				if (!inFile.is_open())
+				{
+					printf("could not open program file '%s'\n", file.c_str());
+					return false;
+				}
 
-		return valueEnd;
-	}
+				text.assign(std::istreambuf_iterator<char>(inFile), std::istreambuf_iterator<char>());
+			}
 
-	const char* getEof(const char* ptr)
-	{
-		while (true)
-		{
-			if (ptr[0] == '\0')
-				break;
+			ShaderLoadScope scope(&m_profiler, file, ShaderLoadPhase::Preprocess);
+			u32 size = 0;
+			auto output = m_preprocessor.preprocess(text.c_str(), static_cast<u32>(text.size()), &size);
+			if (!output)
+			{
+				printf("ShaderPreprocessor: error in file '%s'\n", file.c_str());
+				return false;
+			}
+
+			source->assign(output, size);
+			m_sourceCache.insert(key, *source);
 
-			++ptr;
+			return true;
 		}
 
-		return ptr;
-	}
+		bool ShaderManager::useProgram(vx::gl::ProgramPipeline &pipe, const vx::StringID &sid, const std::string &file)
+		{
+			auto pProgram = getProgram(sid);
+			if (!pProgram)
+			{
+				printf("Error ShaderManager::useProgram '%s'\n", file.c_str());
+				return false;
+			}
 
-	bool hasDefine(const vx::StringID &sid, const vx::sorted_vector<vx::StringID, s32> &localDefines, const vx::sorted_vector<vx::StringID, s32> &globalDefines)
-	{
-		bool found = false;
+			pipe.useProgram(*pProgram);
+			return true;
+		}
 
-		auto it = localDefines.find(sid);
-		if (it != localDefines.end())
+		bool ShaderManager::pipelineExists(const vx::StringID &sid) const
 		{
-			found = true;
+			bool exists = (m_programPipelines.find(sid) != nullptr);
+			for (auto &it : m_pendingPipelines)
+			{
+				exists |= (it.sid == sid);
+			}
+
+			return exists;
 		}
-		else
+
+		bool ShaderManager::beginLoadPipeline(const FileHandle &fileHandle, const char *id, const std::string &pipelineDir,
+			const std::string &programDir, std::string* error)
 		{
-			auto itGlobal = globalDefines.find(sid);
-			if (itGlobal != globalDefines.end())
+			auto sid = vx::make_sid(id);
+			if (pipelineExists(sid))
 			{
-				found = true;
+				printf("Error, pipeline with id '%s' already exists !\n", id);
+				return false;
 			}
-		}
 
-		return found;
-	}
+			std::string stages[6];
+			if (!readPipelineFile(pipelineDir + fileHandle.m_string, stages))
+				return false;
 
-	void handleIfndef(char* ptr, const char* end, std::string* commandValue, 
-		const vx::sorted_vector<vx::StringID, s32> &localDefines, const vx::sorted_vector<vx::StringID, s32> &globalDefines)
-	{
-		auto valueEnd = getCommandValue(end + 1, commandValue);
-		auto sid = vx::make_sid(commandValue->c_str());
+			PendingPipeline pipeline;
+			if (!submitPipeline(stages, programDir, std::string(), DefineOverrides(), &pipeline, error))
+				return false;
+
+			pipeline.sid = sid;
+			pipeline.name = id;
+			m_pendingPipelines.push_back(std::move(pipeline));
 
-		bool found = hasDefine(sid, localDefines, globalDefines);
+			return true;
+		}
 
-		if (found)
+		bool ShaderManager::readPipelineFile(const std::string &file, std::string (&stages)[6])
 		{
-			auto endifEnd = getElseOrEndif(valueEnd);
-			auto endifEndOther = getElseOrEndif(endifEnd + 1);
+			// pipeline files list the vertex, geometry, fragment and compute program in that order
+			const vx::gl::ShaderProgramType stageTypes[4] =
+			{
+				vx::gl::ShaderProgramType::VERTEX,
+				vx::gl::ShaderProgramType::GEOMETRY,
+				vx::gl::ShaderProgramType::FRAGMENT,
+				vx::gl::ShaderProgramType::COMPUTE
+			};
 
-			if (endifEnd != endifEndOther)
+			std::ifstream inFile(file.c_str());
+			if (!inFile.is_open())
 			{
-				auto sizeToElse = endifEnd - ptr;
-				memset(ptr, ' ', sizeToElse);
+				printf("could not open pipeline file '%s'\n", file.c_str());
+				return false;
+			}
 
-				auto endifStart = endifEndOther;
-				while (true)
+			u32 shaderIndex = 0;
+			char buffer[128];
+			while (!inFile.eof())
+			{
+				if (!inFile.getline(buffer, 128) || shaderIndex == 4)
 				{
-					if (endifStart[0] == '#')
-						break;
-
-					--endifStart;
+					puts("error reading line");
+					return false;
 				}
 
-				endifEnd = endifStart;
+				// check for not used shader stage
+				if (strcmp(buffer, "''") != 0)
+				{
+					stages[static_cast<u32>(stageTypes[shaderIndex])] = buffer;
+				}
+				++shaderIndex;
 			}
 
-			auto size = endifEndOther - endifEnd;
-			auto offset = endifEnd - ptr;
-			memset(ptr + offset, ' ', size);
+			return true;
 		}
-	}
-
-	void handleIfDef(char* ptr, const char* end, std::string* commandValue,
-		const vx::sorted_vector<vx::StringID, s32> &localDefines, const vx::sorted_vector<vx::StringID, s32> &globalDefines)
-	{
-		auto valueEnd = getCommandValue(end + 1, commandValue);
 
-		auto sid = vx::make_sid(commandValue->c_str());
-
-		bool found = hasDefine(sid, localDefines, globalDefines);
-
-		if (!found)
+		bool ShaderManager::submitPipeline(const std::string (&stages)[6], const std::string &programDir, const std::string &variant, const DefineOverrides &defines,
+			PendingPipeline* pipeline, std::string* error)
 		{
-			auto endifEnd = getElseOrEndif(valueEnd);
-			auto endifEndOther = getElseOrEndif(endifEnd + 1);
+			DefineOverrides previous;
+			applyDefines(defines, &previous);
+
+			pipeline->target = nullptr;
+			pipeline->stageMask = 0;
 
-			if (endifEnd != endifEndOther)
+			bool result = true;
+			for (u32 i = 0; i < 6; ++i)
 			{
-				auto sizeToElse = endifEnd - ptr;
-				memset(ptr, ' ', sizeToElse);
+				if (stages[i].empty())
+					continue;
 
-				auto endifStart = endifEndOther;
-				while (true)
+				// the same program file built with other defines is a separate program
+				auto programSid = FileHandle(stages[i].c_str()).m_sid;
+				if (!variant.empty())
 				{
-					if (endifStart[0] == '#')
-						break;
+					auto name = stages[i] + "#" + variant;
+					programSid = vx::make_sid(name.c_str());
+				}
 
-					--endifStart;
+				if (!submitProgram(programSid, programDir + stages[i], static_cast<vx::gl::ShaderProgramType>(i), defines, error))
+				{
+					result = false;
+					break;
 				}
 
-				endifEnd = endifStart;
+				pipeline->programs[i] = programSid;
+				pipeline->files[i] = stages[i];
+				pipeline->stageMask |= (1 << i);
 			}
 
-			auto size = endifEndOther - endifEnd;
-			auto offset = endifEnd - ptr;
-			memset(ptr + offset, ' ', size);
+			applyDefines(previous, nullptr);
+
+			return result;
 		}
-	}
 
-	/*void processText(char** text, int bufferSize, const std::string &includeDir, 
-		const vx::sorted_vector<vx::StringID, s32> &globalDefines, vx::sorted_vector<vx::StringID, s32>* localDefines,
-		vx::sorted_vector<vx::StringID, std::string>* includeFiles, vx::sorted_vector<vx::StringID, s32>* includedFiles, vx::StackAllocator* scratchAllocator)
-	{
-		const char* commandDefine = "#define";
-		const char* commandIfdef = "#ifdef";
-		const char* commandIfndef = "#ifndef";
-		const char* commandInclude = "#include";
+		void ShaderManager::applyDefines(const DefineOverrides &defines, DefineOverrides* previous)
+		{
+			for (auto &it : defines)
+			{
+				bool isSet = std::find(m_defines.begin(), m_defines.end(), it.first) != m_defines.end();
+				if (isSet == it.second)
+					continue;
+
+				if (it.second)
+					setDefine(it.first.c_str());
+				else
+					removeDefine(it.first.c_str());
 
-		std::string command;
-		std::string commandValue;
+				if (previous)
+				{
+					previous->push_back(std::make_pair(it.first, isSet));
+				}
+			}
+		}
 
-		char* ptr = *text;
-		while (true)
+		bool ShaderManager::beginLoadPipeline(const FileHandle &fileHandle, const char *id, std::string* error)
 		{
-			auto c = ptr[0];
-			if (c == '\0')
-				break;
+			auto pipelineDir = m_dataDir + "shaders/";
+			const std::string programDir(m_dataDir + "shaders/programs/");
 
-			if (c == '#')
-			{
-				auto end = getPreprocessorCommandEnd(ptr);
+			return beginLoadPipeline(fileHandle, id, pipelineDir, programDir, error);
+		}
 
-				command.clear();
-				command.assign(ptr, end);
+		bool ShaderManager::beginLoadManifest(const char* file, std::string* error)
+		{
+			ShaderManifest manifest;
+			if (!manifest.open(file, error))
+				return false;
 
-				if (strcmp(command.c_str(), commandDefine) == 0)
-				{
-					getCommandValue(end + 1, &commandValue);
+			const std::string programDir(m_dataDir + "shaders/programs/");
 
-					auto sid = vx::make_sid(commandValue.c_str());
-					localDefines->insert(sid, 1);
+			bool result = true;
+			for (u32 i = 0; i < manifest.getPipelineCount(); ++i)
+			{
+				auto &entry = manifest.getPipeline(i);
+				auto id = entry.id.str();
+
+				auto sid = vx::make_sid(id.c_str());
+				if (pipelineExists(sid))
+				{
+					printf("Error, pipeline with id '%s' already exists !\n", id.c_str());
+					result = false;
+					continue;
 				}
-				else if (strcmp(command.c_str(), commandIfdef) == 0)
+
+				std::string stages[6];
+				for (u32 j = 0; j < 6; ++j)
 				{
-					handleIfDef(ptr, end, &commandValue, *localDefines, globalDefines);
+					stages[j] = entry.stages[j].str();
 				}
-				else if (strcmp(command.c_str(), commandIfndef) == 0)
+
+				DefineOverrides defines;
+				for (u32 j = 0; j < entry.defineCount; ++j)
 				{
-					handleIfndef(ptr, end, &commandValue, *localDefines, globalDefines);
+					defines.push_back(std::make_pair(manifest.getDefine(entry.firstDefine + j).str(), true));
 				}
-				else if (strcmp(command.c_str(), commandInclude) == 0)
+
+				// programs only share an id with other pipelines if they are built without extra defines
+				PendingPipeline pipeline;
+				if (!submitPipeline(stages, programDir, defines.empty() ? std::string() : id, defines, &pipeline, error))
 				{
-					auto includeFileStart = getInclude(end + 1) + 1;
-					auto includeFileEnd = getInclude(includeFileStart + 1);
+					result = false;
+					continue;
+				}
 
-					commandValue.clear();
-					commandValue.assign(includeFileStart, includeFileEnd);
+				pipeline.sid = sid;
+				pipeline.name = std::move(id);
+				m_pendingPipelines.push_back(std::move(pipeline));
+			}
 
-					auto sid = vx::make_sid(commandValue.c_str());
+			return result;
+		}
 
-					auto itIncluded = includedFiles->find(sid);
-					if (itIncluded == includedFiles->end())
-					{
-						auto it = includeFiles->find(sid);
-						if (it == includeFiles->end())
-						{
-							std::string file = includeDir + commandValue;
-							//file.pop_back();
+		bool ShaderManager::loadManifest(const char* file, std::string* error)
+		{
+			bool result = beginLoadManifest(file, error);
+			result &= finishLoading(error);
 
-							char* includeBuffer = nullptr;
-							//printf("trying to open file %s\n", file.c_str());
+			return result;
+		}
 
-							u32 includeSize = 0;
-							if (loadFile(file.c_str(), &includeBuffer, includeSize, scratchAllocator))
-							{
-								std::string includeFile;
-								includeFile.assign(includeBuffer);
+		bool ShaderManager::isLoadingComplete() const
+		{
+			for (auto &it : m_pendingPrograms)
+			{
+				if (!it.program.isCompileComplete())
+					return false;
+			}
 
-								includedFiles->insert(sid, 1);
-								it = includeFiles->insert(std::move(sid), std::move(includeFile));
-							}
-						}
+			return true;
+		}
 
-						if (it != includeFiles->end())
-						{
-							auto includeSize = it->size();
+		bool ShaderManager::finishLoading(std::string* error)
+		{
+			return finishPending(0, 0, error);
+		}
 
-							auto eof = getEof(includeFileEnd);
-							auto sizeToEnd = eof - includeFileEnd;
+		bool ShaderManager::finishPending(u32 firstProgram, u32 firstPipeline, std::string* error)
+		{
+			auto pipelineCount = static_cast<u32>(m_pendingPipelines.size());
 
-							bufferSize += includeSize;
-							auto newBuffer = (char*)scratchAllocator->allocate(bufferSize);
+			// programs queued before firstProgram are still finished if one of the pipelines uses them
+			auto isUsed = [&](const vx::StringID &sid)
+			{
+				for (u32 i = firstPipeline; i < pipelineCount; ++i)
+				{
+					auto &pipeline = m_pendingPipelines[i];
+					for (u32 stage = 0; stage < 6; ++stage)
+					{
+						if ((pipeline.stageMask & (1 << stage)) != 0 && pipeline.programs[stage] == sid)
+							return true;
+					}
+				}
 
-							int copiedSize = 0;
-							auto sizeToInclude = ptr - *text;
-							memcpy(newBuffer, *text, sizeToInclude);
-							copiedSize += sizeToInclude;
-							memcpy(newBuffer + sizeToInclude, it->c_str(), includeSize);
-							copiedSize += includeSize;
-							memcpy(newBuffer + copiedSize, includeFileEnd + 1, sizeToEnd);
+				return false;
+			};
 
-							*text = newBuffer;
+			m_shaderPrograms.reserve(m_shaderPrograms.size() + static_cast<u32>(m_pendingPrograms.size()));
+			m_programPipelines.reserve(m_programPipelines.size() + pipelineCount - firstPipeline);
 
-							ptr = *text + sizeToInclude;
-						}
+			bool result = true;
+			u32 remaining = 0;
+			for (u32 i = 0; i < m_pendingPrograms.size(); ++i)
+			{
+				auto &it = m_pendingPrograms[i];
+				if (i < firstProgram && !isUsed(it.sid))
+				{
+					// keep the queue in submission order
+					if (remaining != i)
+					{
+						m_pendingPrograms[remaining] = std::move(it);
 					}
+					++remaining;
+					continue;
+				}
+
+				if (finishProgram(&it, error))
+				{
+					m_shaderPrograms.insert(it.sid, std::move(it.program));
 				}
 				else
 				{
-					//	printf("Not supported: %s\n", command.c_str());
+					result = false;
 				}
 			}
+			m_pendingPrograms.erase(m_pendingPrograms.begin() + remaining, m_pendingPrograms.end());
 
-			++ptr;
-		}
-	}
-
-	/*bool loadShaderProgram(const char* programFile,
-		const char* fileName,
-		const std::string &includeDir, const vx::sorted_vector<vx::StringID, vx::gl::ShaderParameter> &params,
-		const vx::sorted_vector<vx::StringID, s32> &globalDefines,
-		vx::gl::ShaderProgram* program, vx::sorted_vector<vx::StringID, std::string>* includeFiles, vx::StackAllocator* scratchAllocator)
-	{
-		auto allocMarker = scratchAllocator->getMarker();
-		SCOPE_EXIT
-		{
-			scratchAllocator->clear(allocMarker);
-		};
-			
-		char* programBuffer = nullptr;
-		u32 programSize;
-		if (!loadFile(programFile, &programBuffer, programSize, scratchAllocator))
-			return false;
+			for (u32 i = firstPipeline; i < pipelineCount; ++i)
+			{
+				auto &it = m_pendingPipelines[i];
+				ShaderLoadScope scope(&m_profiler, it.name, ShaderLoadPhase::Pipeline);
 
-		vx::sorted_vector<vx::StringID, s32> localDefines;
+				vx::gl::ProgramPipeline pipe;
+				pipe.create();
 
-		vx::sorted_vector<vx::StringID, s32> included;
-		processText(&programBuffer, programSize, includeDir, globalDefines, &localDefines, includeFiles, &included, scratchAllocator);
+				bool valid = true;
+				for (u32 stage = 0; stage < 6; ++stage)
+				{
+					if ((it.stageMask & (1 << stage)) != 0)
+					{
+						valid = valid && useProgram(pipe, it.programs[stage], it.files[stage]);
+					}
+				}
 
-		while (insertParameter(&programBuffer, params, scratchAllocator))
-			;
+				if (valid)
+				{
+					if (it.target)
+						*it.target = std::move(pipe);
+					else
+						m_programPipelines.insert(it.sid, std::move(pipe));
+				}
+				result &= valid;
+			}
+			m_pendingPipelines.erase(m_pendingPipelines.begin() + firstPipeline, m_pendingPipelines.end());
 
-		const char* ptr = programBuffer;
+			return result;
+		}
 
-		s32 logSize = 0;
-		auto log = program->create(&ptr, logSize);
-		if (log)
+		bool ShaderManager::loadPipeline(const FileHandle &fileHandle, const char *id, vx::StackAllocator*, std::string* error)
 		{
-			printf("Error '%s'\n%s\n", programFile, log.get());
+			if (!beginLoadPipeline(fileHandle, id, error))
+				return false;
 
-			std::string errorFile("error_");
-			errorFile.append(fileName);
-			std::ofstream outFile(errorFile);
-			outFile << ptr;
-			//printf("%s\n", ptr);
+			return finishLoading(error);
+		}
 
-			return false;
+		void ShaderManager::addParameter(const char* id, s32 value)
+		{
+			char buffer[32];
+			snprintf(buffer, sizeof(buffer), "%d", value);
+			setParameter(id, buffer);
 		}
 
-		return true;
-	}*/
-}
+		void ShaderManager::addParameter(const char* id, u32 value)
+		{
+			char buffer[32];
+			snprintf(buffer, sizeof(buffer), "%u", value);
+			setParameter(id, buffer);
+		}
 
-namespace vx
-{
-	namespace gl
-	{
-		struct ShaderManager::LoadUseProgramDescription
+		void ShaderManager::addParameter(const char* id, f32 value)
 		{
-			vx::gl::ProgramPipeline* pipe;
-			const char* id;
-			ShaderProgramType type;
-			const std::string* programDir;
-			const std::string* includeDir;
-		};
+			// glsl has no hex floats, 9 digits keep the value exact
+			char buffer[32];
+			auto size = snprintf(buffer, sizeof(buffer), "%.9g", value);
+			if (strpbrk(buffer, ".en") == nullptr && size + 2 < (s32)sizeof(buffer))
+			{
+				strcat(buffer, ".0");
+			}
+			setParameter(id, buffer);
+		}
 
-		ShaderManager::ShaderManager()
-			:m_programPipelines(),
-			m_shaderPrograms(),
-			m_textPreprocessor()
+		void ShaderManager::setDefine(const char* define)
 		{
+			m_preprocessor.setDefine(define);
 
+			if (std::find(m_defines.begin(), m_defines.end(), define) == m_defines.end())
+			{
+				m_defines.push_back(define);
+				m_stateHashDirty = true;
+			}
 		}
 
-		ShaderManager::~ShaderManager()
+		void ShaderManager::removeDefine(const char* define)
 		{
+			m_preprocessor.removeDefine(define);
+
+			auto it = std::find(m_defines.begin(), m_defines.end(), define);
+			if (it != m_defines.end())
+			{
+				m_defines.erase(it);
+				m_stateHashDirty = true;
+			}
 		}
 
-		void ShaderManager::initialize(const std::string &dataDir)
+		void ShaderManager::addIncludeFile(const char* file, const char* key)
 		{
-			m_dataDir = dataDir;
+			m_preprocessor.loadIncludeFile(file, key);
+			m_fileHashes.clear();
+
+			for (auto &it : m_includeFiles)
+			{
+				if (it.key == key)
+				{
+					it.file = file;
+					it.watchIndex = m_fileWatcher.addFile(it.file);
+					return;
+				}
+			}
+
+			IncludeFile includeFile;
+			includeFile.file = file;
+			includeFile.key = key;
+			includeFile.watchIndex = m_fileWatcher.addFile(includeFile.file);
+			m_includeFiles.push_back(std::move(includeFile));
 		}
 
-		void ShaderManager::clear()
+		void ShaderManager::enableHotReload(bool enable)
 		{
-			m_programPipelines.clear();
-			m_shaderPrograms.clear();
+			m_hotReload = enable;
 		}
 
-		bool ShaderManager::loadProgram(const FileHandle &programHandle, vx::gl::ShaderProgramType type, const std::string &programDir, const std::string &includeDir, vx::StackAllocator* scratchAllocator, std::string* error)
+		u32 ShaderManager::reloadChangedPrograms(std::string* error)
 		{
-			auto programFile = programDir + programHandle.m_string;
+			if (!m_hotReload)
+				return 0;
+
+			std::vector<u32> changed;
+			if (m_fileWatcher.poll(&changed) == 0)
+				return 0;
 
-			auto sid = programHandle.m_sid;
-			auto it = m_shaderPrograms.find(sid);
-			if (it == m_shaderPrograms.end())
+			auto isChanged = [&changed](u32 index)
 			{
-				auto programData = m_textPreprocessor.preprocessFile(programFile.c_str());
-				vx::gl::ShaderProgram program(type);
+				return std::find(changed.begin(), changed.end(), index) != changed.end();
+			};
 
-				const char* ptr = programData.c_str();
+			m_fileHashes.clear();
 
-				s32 logSize = 0;
-				auto log = program.create(&ptr, logSize);
-				if (log)
+			// the preprocessor keeps its own copy of registered include files
+			for (auto &it : m_includeFiles)
+			{
+				if (isChanged(it.watchIndex))
 				{
-					//printf("Error '%s'\n%s\n", programFile, log.get());
-					error->append("shader error: ");
-					error->append(programFile);
-					error->push_back('\n');
+					m_preprocessor.loadIncludeFile(it.file.c_str(), it.key.c_str());
+				}
+			}
+			m_preprocessor.clearIncludeCache();
 
-					error->append(log.get());
+			// submit all affected programs before waiting for any of them
+			std::vector<PendingProgram> reloads;
+			for (auto &source : m_programSources)
+			{
+				bool affected = false;
+				for (auto it : source.dependencies)
+				{
+					affected |= isChanged(it);
+				}
 
-					std::string errorFile("error_");
-					errorFile.append(programHandle.m_string);
-					std::ofstream outFile(errorFile);
-					outFile << ptr;
+				if (!affected || !m_shaderPrograms.find(source.sid))
+					continue;
 
-					return false;
+				DefineOverrides previous;
+				applyDefines(source.defines, &previous);
+
+				PendingProgram pending(source.type);
+				pending.sid = source.sid;
+				pending.file = source.file;
+				if (createProgram(&pending, error))
+				{
+					reloads.push_back(std::move(pending));
 				}
 
-				m_shaderPrograms.insert(std::move(sid), std::move(program));
+				applyDefines(previous, nullptr);
+			}
 
-				/*vx::gl::ShaderProgram program(type);
-				if (!ShaderManagerCpp::loadShaderProgram(programFile.c_str(), programHandle.m_string, includeDir, m_parameters, m_defines, &program, &m_includeFiles, scratchAllocator))
+			u32 count = 0;
+			for (auto &it : reloads)
+			{
+				if (!finishProgram(&it, error))
+					continue;
+
+				auto current = m_shaderPrograms.find(it.sid);
+				auto oldId = current->getId();
+				auto type = current->getType();
+
+				for (auto &pipe : m_programPipelines)
 				{
-					printf("Error ShaderManager::loadProgram\n");
-					return false;
+					if (pipe[type] == oldId)
+					{
+						pipe.useProgram(it.program);
+					}
 				}
 
-				m_shaderPrograms.insert(std::move(sid), std::move(program));*/
+				for (auto &set : m_permutationSets)
+				{
+					for (u32 i = 0; i < set->getVariantCount(); ++i)
+					{
+						auto pipe = set->getVariant(i);
+						if (pipe->isValid() && (*pipe)[type] == oldId)
+						{
+							pipe->useProgram(it.program);
+						}
+					}
+				}
+
+				// the old program ends up in the pending entry and is deleted with it
+				*current = std::move(it.program);
+				++count;
+
+				// the edit may have added or removed includes
+				auto source = m_programSources.find(it.sid);
+				if (source)
+				{
+					source->dependencies.clear();
+					addDependencies(source->file, &source->dependencies);
+				}
 			}
 
-			return true;
+			return count;
 		}
 
-		bool ShaderManager::useProgram(vx::gl::ProgramPipeline &pipe, const FileHandle &handle)
+		ShaderPermutationSet* ShaderManager::getPermutationSet(const vx::StringID &sid, u32* index) const
 		{
-			auto pProgram = getProgram(handle.m_sid);
-			if (!pProgram)
-			{
-				printf("Error ShaderManager::useProgram '%s'\n", handle.m_string);
-				return false;
-			}
+			auto it = m_permutationIndices.find(sid);
+			if (it == m_permutationIndices.end())
+				return nullptr;
 
-			pipe.useProgram(*pProgram);
-			return true;
+			*index = *it;
+			return m_permutationSets[*it].get();
 		}
 
-		bool ShaderManager::loadUseProgram(const LoadUseProgramDescription &desc, vx::StackAllocator* scratchAllocator, std::string* error)
+		bool ShaderManager::submitPermutation(u32 permutationSet, u64 mask, std::string* error)
 		{
-			// check for not used shader stage
-			if (strcmp(desc.id, "''") == 0)
+			auto set = m_permutationSets[permutationSet].get();
+
+			std::vector<const char*> enabled, disabled;
+			if (!set->getDefines(mask, &enabled, &disabled))
 			{
-				return true;
+				printf("Error, invalid permutation mask %llx for '%s'\n", static_cast<unsigned long long>(mask), set->getId().c_str());
+				return false;
 			}
 
-			auto fileHandle = FileHandle(desc.id);
-			if (!loadProgram(fileHandle, desc.type, *desc.programDir, *desc.includeDir, scratchAllocator, error))
+			// a variant that fails keeps its empty pipeline so it is not compiled again on every request
+			auto target = set->insert(mask);
+
+			std::string stages[6];
+			if (!readPipelineFile(set->getPipelineFile(), stages))
 				return false;
-			if (!useProgram(*desc.pipe, fileHandle))
+
+			DefineOverrides defines;
+			for (auto it : enabled)
+			{
+				defines.push_back(std::make_pair(std::string(it), true));
+			}
+			for (auto it : disabled)
+			{
+				defines.push_back(std::make_pair(std::string(it), false));
+			}
+
+			char variant[32];
+			snprintf(variant, sizeof(variant), ":%llx", static_cast<unsigned long long>(mask));
+
+			PendingPipeline pipeline;
+			if (!submitPipeline(stages, m_dataDir + "shaders/programs/", set->getId() + variant, defines, &pipeline, error))
 				return false;
 
+			pipeline.name = set->getId() + variant;
+			pipeline.target = target;
+			m_pendingPipelines.push_back(std::move(pipeline));
+
 			return true;
 		}
 
-		bool ShaderManager::loadPipeline(const FileHandle &fileHandle, const char *id, const std::string &pipelineDir, 
-			const std::string &programDir, const std::string &includeDir, vx::StackAllocator* scratchAllocator, std::string* error)
+		bool ShaderManager::declarePermutations(const FileHandle &fileHandle, const char* id, const ShaderPermutationKey* keys, u32 keyCount)
 		{
 			auto sid = vx::make_sid(id);
-			auto it = m_programPipelines.find(sid);
-			if (it != m_programPipelines.end())
+			if (m_permutationIndices.find(sid) != m_permutationIndices.end())
 			{
-				printf("Error, pipeline with id '%s' already exists !\n", id);
+				printf("Error, permutations with id '%s' already exist !\n", id);
 				return false;
 			}
 
-			auto pipelineFileWithPath = pipelineDir + fileHandle.m_string;
-
-			std::ifstream inFile(pipelineFileWithPath.c_str());
-			if (!inFile.is_open())
-			{
-				printf("could not open pipeline file '%s'\n", pipelineFileWithPath.c_str());
-				printf("'%s'\n", fileHandle.m_string);
+			std::unique_ptr<ShaderPermutationSet> set(new ShaderPermutationSet());
+			if (!set->initialize(id, m_dataDir + "shaders/" + fileHandle.m_string, keys, keyCount))
 				return false;
-			}
 
-			std::string shaders[4];
-			u32 shaderIndex = 0;
-			char buffer[128];
-			while (!inFile.eof())
-			{
-				if (!inFile.getline(buffer, 128))
-				{
-					puts("error reading line");
-					return false;
-				}
+			m_permutationIndices.insert(std::move(sid), static_cast<u32>(m_permutationSets.size()));
+			m_permutationSets.push_back(std::move(set));
 
-				shaders[shaderIndex++] = buffer;
-			}
+			return true;
+		}
 
-			vx::gl::ProgramPipeline pipe;
-			pipe.create();
+		const vx::gl::ProgramPipeline* ShaderManager::getPermutation(const vx::StringID &sid, u64 mask, std::string* error)
+		{
+			u32 index = 0;
+			auto set = getPermutationSet(sid, &index);
+			if (!set)
+				return nullptr;
 
-			LoadUseProgramDescription desc;
-			desc.includeDir = &includeDir;
-			desc.pipe = &pipe;
-			desc.programDir = &programDir;
+			auto pipeline = set->find(mask);
+			if (!pipeline)
+			{
+				// only wait for this variant, work queued by beginLoad* stays pending
+				auto firstProgram = static_cast<u32>(m_pendingPrograms.size());
+				auto firstPipeline = static_cast<u32>(m_pendingPipelines.size());
+				if (!submitPermutation(index, mask, error))
+					return nullptr;
 
-			desc.id = shaders[0].c_str();
-			desc.type = vx::gl::ShaderProgramType::VERTEX;
-			if (!loadUseProgram(desc, scratchAllocator, error))
-				return false;
+				if (!finishPending(firstProgram, firstPipeline, error))
+					return nullptr;
 
-			desc.id = shaders[1].c_str();
-			desc.type = vx::gl::ShaderProgramType::GEOMETRY;
-			if (!loadUseProgram(desc, scratchAllocator, error))
-				return false;
+				pipeline = set->find(mask);
+			}
 
-			desc.id = shaders[2].c_str();
-			desc.type = vx::gl::ShaderProgramType::FRAGMENT;
-			if (!loadUseProgram(desc, scratchAllocator, error))
-				return false;
+			return pipeline->isValid() ? pipeline : nullptr;
+		}
 
-			desc.id = shaders[3].c_str();
-			desc.type = vx::gl::ShaderProgramType::COMPUTE;
-			if (!loadUseProgram(desc, scratchAllocator, error))
+		bool ShaderManager::prewarmPermutations(const vx::StringID &sid, const u64* masks, u32 count, std::string* error)
+		{
+			u32 index = 0;
+			auto set = getPermutationSet(sid, &index);
+			if (!set)
 				return false;
 
-		//	printf("Added pipeline '%s'\n", id);
-			m_programPipelines.insert(std::move(sid), std::move(pipe));
+			bool result = true;
+			for (u32 i = 0; i < count; ++i)
+			{
+				if (!set->find(masks[i]))
+				{
+					result &= submitPermutation(index, masks[i], error);
+				}
+			}
+
+			result &= finishLoading(error);
 
-			return true;
+			return result;
 		}
 
-		bool ShaderManager::loadPipeline(const FileHandle &fileHandle, const char *id, vx::StackAllocator* scratchAllocator, std::string* error)
+		const vx::gl::ShaderProgram* ShaderManager::getProgram(const vx::StringID &sid) const
 		{
-			auto pipelineDir = m_dataDir + "shaders/";
-			const std::string programDir(m_dataDir + "shaders/programs/");
-			const std::string includeDir = m_dataDir + "shaders/include/";
-
-			return loadPipeline(fileHandle, id, pipelineDir, programDir, includeDir, scratchAllocator, error);
+			return m_shaderPrograms.find(sid);
 		}
 
-		void ShaderManager::addParameter(const char* id, s32 value)
+		const vx::gl::ProgramPipeline* ShaderManager::getPipeline(const char* id) const
 		{
-			m_textPreprocessor.setCustomValue(id, value);
+			return getPipeline(vx::make_sid(id));
 		}
 
-		void ShaderManager::addParameter(const char* id, u32 value)
+		const vx::gl::ProgramPipeline* ShaderManager::getPipeline(const vx::StringID &sid) const
 		{
-			m_textPreprocessor.setCustomValue(id, value);
+			return m_programPipelines.find(sid);
 		}
 
-		void ShaderManager::addParameter(const char* id, f32 value)
+		void ShaderManager::enableProfiling(bool enable)
 		{
-			m_textPreprocessor.setCustomValue(id, value);
+			m_profiler.enable(enable);
 		}
 
-		void ShaderManager::setDefine(const char* define)
+		void ShaderManager::setPrewarmState(u32 vao, u32 framebuffer)
 		{
-			m_textPreprocessor.setDefine(define);
+			m_prewarmer.setState(vao, framebuffer);
 		}
 
-		void ShaderManager::removeDefine(const char* define)
+		bool ShaderManager::prewarmPipelines(f32 budgetMilliseconds)
 		{
-			m_textPreprocessor.removeDefine(define);
+			if (m_prewarmedCount == m_programPipelines.size())
+				return true;
+
+			auto start = std::chrono::high_resolution_clock::now();
+
+			m_prewarmer.begin();
+			while (m_prewarmedCount < m_programPipelines.size())
+			{
+				m_prewarmer.warm(m_programPipelines.getKey(m_prewarmedCount), m_programPipelines[m_prewarmedCount]);
+				++m_prewarmedCount;
+
+				std::chrono::duration<f32, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+				if (elapsed.count() >= budgetMilliseconds)
+					break;
+			}
+			m_prewarmer.end();
+
+			return m_prewarmedCount == m_programPipelines.size();
 		}
 
-		void ShaderManager::addIncludeFile(const char* file, const char* key)
+		void ShaderManager::getSlowestPrewarms(u32 count, std::vector<PipelinePrewarmTime>* times) const
 		{
-			m_textPreprocessor.loadIncludeFile(file, key);
+			m_prewarmer.getSlowest(count, times);
 		}
 
-		const vx::gl::ShaderProgram* ShaderManager::getProgram(const vx::StringID &sid) const
+		u32 ShaderManager::getPipelineHandle(const char* id) const
 		{
-			auto it = m_shaderPrograms.find(sid);
-			if (it == m_shaderPrograms.end())
-				return nullptr;
-
-			return &*it;
+			return getPipelineHandle(vx::make_sid(id));
 		}
 
-		const vx::gl::ProgramPipeline* ShaderManager::getPipeline(const char* id) const
+		u32 ShaderManager::getPipelineHandle(const vx::StringID &sid) const
 		{
-			return getPipeline(vx::make_sid(id));
+			return m_programPipelines.getHandle(sid);
 		}
 
-		const vx::gl::ProgramPipeline* ShaderManager::getPipeline(const vx::StringID &sid) const
+		const vx::gl::ProgramPipeline* ShaderManager::getPipelineByHandle(u32 handle) const
 		{
-			auto it = m_programPipelines.find(sid);
-			if (it == m_programPipelines.end())
+			if (handle >= m_programPipelines.size())
 				return nullptr;
 
-			return &*it;
+			return &m_programPipelines[handle];
 		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,271 @@
+/*
+The MIT License(MIT)
+
+Copyright(c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/ShaderManifest.h>
+#include <Windows.h>
+
+namespace ShaderManifestCpp
+{
+	struct Directive
+	{
+		const char* name;
+		s32 stage; // ShaderProgramType or a negative directive
+	};
+
+	const s32 g_pipelineDirective = -1;
+	const s32 g_defineDirective = -2;
+
+	const Directive g_directives[] =
+	{
+		{ "pipeline", g_pipelineDirective },
+		{ "define", g_defineDirective },
+		{ "vertex", static_cast<s32>(vx::gl::ShaderProgramType::VERTEX) },
+		{ "tess_control", static_cast<s32>(vx::gl::ShaderProgramType::TESS_CONTROL) },
+		{ "tess_eval", static_cast<s32>(vx::gl::ShaderProgramType::TESS_EVAL) },
+		{ "geometry", static_cast<s32>(vx::gl::ShaderProgramType::GEOMETRY) },
+		{ "fragment", static_cast<s32>(vx::gl::ShaderProgramType::FRAGMENT) },
+		{ "compute", static_cast<s32>(vx::gl::ShaderProgramType::COMPUTE) }
+	};
+
+	inline bool isSpace(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\r';
+	}
+
+	// returns the next token of the line, size 0 at the end of the line
+	vx::gl::ShaderManifestString nextToken(const char** ptr, const char* lineEnd)
+	{
+		auto p = *ptr;
+		while (p < lineEnd && isSpace(*p))
+			++p;
+
+		vx::gl::ShaderManifestString token;
+		token.ptr = p;
+		while (p < lineEnd && !isSpace(*p))
+			++p;
+		token.size = static_cast<u32>(p - token.ptr);
+
+		*ptr = p;
+		return token;
+	}
+
+	bool equals(const vx::gl::ShaderManifestString &token, const char* str)
+	{
+		return strncmp(token.ptr, str, token.size) == 0 && str[token.size] == '\0';
+	}
+
+	void appendError(std::string* error, u32 line, const char* message)
+	{
+		char buffer[128];
+		snprintf(buffer, sizeof(buffer), "shader manifest error: line %u: %s\n", line, message);
+		error->append(buffer);
+	}
+}
+
+namespace vx
+{
+	namespace gl
+	{
+		ShaderManifest::ShaderManifest()
+			:m_file(INVALID_HANDLE_VALUE),
+			m_mapping(nullptr),
+			m_data(nullptr),
+			m_size(0),
+			m_pipelines(),
+			m_defines()
+		{
+		}
+
+		ShaderManifest::~ShaderManifest()
+		{
+			close();
+		}
+
+		bool ShaderManifest::open(const char* file, std::string* error)
+		{
+			close();
+
+			m_file = CreateFileA(file, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			if (m_file == INVALID_HANDLE_VALUE)
+			{
+				error->append("shader manifest error: could not open ");
+				error->append(file);
+				error->push_back('\n');
+				return false;
+			}
+
+			LARGE_INTEGER size;
+			if (!GetFileSizeEx(m_file, &size) || size.QuadPart > 0xffffffff)
+			{
+				close();
+				return false;
+			}
+			m_size = static_cast<u32>(size.QuadPart);
+
+			// empty files can not be mapped
+			if (m_size != 0)
+			{
+				m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+				if (m_mapping)
+				{
+					m_data = (const char*)MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+				}
+
+				if (!m_data)
+				{
+					close();
+					return false;
+				}
+			}
+
+			if (!parse(error))
+			{
+				close();
+				return false;
+			}
+
+			return true;
+		}
+
+		void ShaderManifest::close()
+		{
+			if (m_data)
+			{
+				UnmapViewOfFile(m_data);
+				m_data = nullptr;
+			}
+
+			if (m_mapping)
+			{
+				CloseHandle(m_mapping);
+				m_mapping = nullptr;
+			}
+
+			if (m_file != INVALID_HANDLE_VALUE)
+			{
+				CloseHandle(m_file);
+				m_file = INVALID_HANDLE_VALUE;
+			}
+
+			m_size = 0;
+			m_pipelines.clear();
+			m_defines.clear();
+		}
+
+		bool ShaderManifest::parse(std::string* error)
+		{
+			auto ptr = m_data;
+			auto end = m_data + m_size;
+			u32 line = 0;
+
+			while (ptr < end)
+			{
+				++line;
+				auto lineEnd = (const char*)memchr(ptr, '\n', end - ptr);
+				if (!lineEnd)
+					lineEnd = end;
+
+				auto directive = ShaderManifestCpp::nextToken(&ptr, lineEnd);
+				if (directive.size != 0 && directive.ptr[0] != '#')
+				{
+					auto argument = ShaderManifestCpp::nextToken(&ptr, lineEnd);
+					auto extra = ShaderManifestCpp::nextToken(&ptr, lineEnd);
+					if (argument.size == 0 || extra.size != 0)
+					{
+						ShaderManifestCpp::appendError(error, line, "expected one argument");
+						return false;
+					}
+
+					s32 stage = 0;
+					bool found = false;
+					for (auto &it : ShaderManifestCpp::g_directives)
+					{
+						if (ShaderManifestCpp::equals(directive, it.name))
+						{
+							stage = it.stage;
+							found = true;
+							break;
+						}
+					}
+
+					if (!found)
+					{
+						ShaderManifestCpp::appendError(error, line, "unknown directive");
+						return false;
+					}
+
+					if (stage == ShaderManifestCpp::g_pipelineDirective)
+					{
+						ShaderManifestPipeline pipeline;
+						memset(&pipeline, 0, sizeof(pipeline));
+						pipeline.id = argument;
+						pipeline.firstDefine = static_cast<u32>(m_defines.size());
+						m_pipelines.push_back(pipeline);
+					}
+					else if (m_pipelines.empty())
+					{
+						ShaderManifestCpp::appendError(error, line, "directive outside of a pipeline");
+						return false;
+					}
+					else if (stage == ShaderManifestCpp::g_defineDirective)
+					{
+						m_defines.push_back(argument);
+						++m_pipelines.back().defineCount;
+					}
+					else
+					{
+						auto &current = m_pipelines.back().stages[stage];
+						if (current.size != 0)
+						{
+							ShaderManifestCpp::appendError(error, line, "stage declared twice");
+							return false;
+						}
+						current = argument;
+					}
+				}
+
+				ptr = lineEnd + 1;
+			}
+
+			for (auto &it : m_pipelines)
+			{
+				bool empty = true;
+				for (auto &stage : it.stages)
+				{
+					empty &= (stage.size == 0);
+				}
+
+				if (empty)
+				{
+					error->append("shader manifest error: pipeline ");
+					error->append(it.id.ptr, it.id.size);
+					error->append(" has no stages\n");
+					return false;
+				}
+			}
+
+			return true;
+		}
+	}
+}
\ No newline at end of file
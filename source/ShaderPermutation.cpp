@@ -0,0 +1,126 @@
+/*
+The MIT License(MIT)
+
+Copyright(c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/ShaderPermutation.h>
+#include <vxGL/ProgramPipeline.h>
+
+namespace vx
+{
+	namespace gl
+	{
+		ShaderPermutationSet::ShaderPermutationSet()
+			:m_keys(),
+			m_defines(),
+			m_pipelines(),
+			m_id(),
+			m_pipelineFile()
+		{
+		}
+
+		ShaderPermutationSet::~ShaderPermutationSet()
+		{
+		}
+
+		bool ShaderPermutationSet::initialize(const char* id, const std::string &pipelineFile, const ShaderPermutationKey* keys, u32 keyCount)
+		{
+			u32 shift = 0;
+			for (u32 i = 0; i < keyCount; ++i)
+			{
+				VX_ASSERT(keys[i].defineCount != 0);
+
+				u32 bits = 1;
+				if (keys[i].defineCount > 1)
+				{
+					bits = 0;
+					while ((1u << bits) < keys[i].defineCount)
+						++bits;
+				}
+
+				if (shift + bits > 64)
+				{
+					printf("ShaderPermutationSet: keys of '%s' need more than 64 bits\n", id);
+					return false;
+				}
+
+				Key key;
+				key.firstDefine = static_cast<u32>(m_defines.size());
+				key.defineCount = keys[i].defineCount;
+				key.shift = static_cast<u8>(shift);
+				key.bits = static_cast<u8>(bits);
+				m_keys.push_back(key);
+
+				for (u32 j = 0; j < keys[i].defineCount; ++j)
+				{
+					m_defines.push_back(keys[i].defines[j]);
+				}
+
+				shift += bits;
+			}
+
+			m_id = id;
+			m_pipelineFile = pipelineFile;
+
+			return true;
+		}
+
+		bool ShaderPermutationSet::getDefines(u64 mask, std::vector<const char*>* enabled, std::vector<const char*>* disabled) const
+		{
+			u64 usedBits = 0;
+			for (auto &key : m_keys)
+			{
+				u64 keyMask = (1ull << key.bits) - 1;
+				u32 value = static_cast<u32>((mask >> key.shift) & keyMask);
+				usedBits |= keyMask << key.shift;
+
+				for (u32 i = 0; i < key.defineCount; ++i)
+				{
+					// a bool key is enabled by its bit, an enum key by its value index
+					bool selected = (key.defineCount == 1) ? (value != 0) : (value == i);
+					auto define = m_defines[key.firstDefine + i].c_str();
+					if (selected)
+						enabled->push_back(define);
+					else
+						disabled->push_back(define);
+				}
+
+				if (key.defineCount > 1 && value >= key.defineCount)
+					return false;
+			}
+
+			return (mask & ~usedBits) == 0;
+		}
+
+		ProgramPipeline* ShaderPermutationSet::find(u64 mask) const
+		{
+			auto pipeline = m_pipelines.find(mask);
+			return (pipeline == nullptr) ? nullptr : pipeline->get();
+		}
+
+		ProgramPipeline* ShaderPermutationSet::insert(u64 mask)
+		{
+			auto handle = m_pipelines.insert(mask, std::unique_ptr<ProgramPipeline>(new ProgramPipeline()));
+			return m_pipelines[handle].get();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,844 @@
+/*
+The MIT License(MIT)
+
+Copyright(c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/ShaderPreprocessor.h>
+#include <vxGL/CacheFile.h>
+#include <algorithm>
+#include <emmintrin.h>
+#include <fstream>
+#include <iterator>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace ShaderPreprocessorCpp
+{
+	const u32 g_maxIncludeDepth = 32;
+	const u32 g_maxExpressionDepth = 8;
+
+	inline u32 countTrailingZeros(u32 mask)
+	{
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return index;
+#else
+		return __builtin_ctz(mask);
+#endif
+	}
+
+	// returns the first c in [ptr, end) or end
+	const char* findChar(const char* ptr, const char* end, char c)
+	{
+		auto pattern = _mm_set1_epi8(c);
+		while (end - ptr >= 16)
+		{
+			auto block = _mm_loadu_si128((const __m128i*)ptr);
+			auto mask = static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern)));
+			if (mask != 0)
+				return ptr + countTrailingZeros(mask);
+
+			ptr += 16;
+		}
+
+		while (ptr < end && *ptr != c)
+			++ptr;
+
+		return ptr;
+	}
+
+	inline bool isSpace(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\r';
+	}
+
+	inline bool isIdentifier(char c)
+	{
+		return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+	}
+
+	inline const char* skipSpace(const char* ptr, const char* end)
+	{
+		while (ptr < end && isSpace(*ptr))
+			++ptr;
+
+		return ptr;
+	}
+
+	inline const char* getIdentifierEnd(const char* ptr, const char* end)
+	{
+		while (ptr < end && isIdentifier(*ptr))
+			++ptr;
+
+		return ptr;
+	}
+
+	inline bool equals(const char* ptr, const char* end, const char* str)
+	{
+		auto size = static_cast<size_t>(end - ptr);
+		return strlen(str) == size && memcmp(ptr, str, size) == 0;
+	}
+
+	inline u64 hash(const char* ptr, u32 size)
+	{
+		return vx::gl::hashFnv1a(ptr, size);
+	}
+
+	// evaluates #if expressions
+	struct Expression
+	{
+		const vx::gl::ShaderPreprocessor* preprocessor;
+		const char* ptr;
+		const char* end;
+		u32 depth;
+		bool error;
+
+		bool match(const char* op)
+		{
+			ptr = skipSpace(ptr, end);
+
+			auto size = strlen(op);
+			if (static_cast<size_t>(end - ptr) < size || memcmp(ptr, op, size) != 0)
+				return false;
+
+			ptr += size;
+			return true;
+		}
+
+		s64 parseOr()
+		{
+			auto value = parseAnd();
+			while (match("||"))
+			{
+				auto rhs = parseAnd();
+				value = (value != 0 || rhs != 0) ? 1 : 0;
+			}
+
+			return value;
+		}
+
+		s64 parseAnd()
+		{
+			auto value = parseComparison();
+			while (match("&&"))
+			{
+				auto rhs = parseComparison();
+				value = (value != 0 && rhs != 0) ? 1 : 0;
+			}
+
+			return value;
+		}
+
+		s64 parseComparison()
+		{
+			auto value = parseUnary();
+			if (match("=="))
+				return value == parseUnary();
+			if (match("!="))
+				return value != parseUnary();
+			if (match("<="))
+				return value <= parseUnary();
+			if (match(">="))
+				return value >= parseUnary();
+			if (match("<"))
+				return value < parseUnary();
+			if (match(">"))
+				return value > parseUnary();
+
+			return value;
+		}
+
+		s64 parseUnary()
+		{
+			if (match("!"))
+				return parseUnary() == 0;
+			if (match("-"))
+				return -parseUnary();
+
+			return parsePrimary();
+		}
+
+		s64 parseNumber()
+		{
+			s64 value = 0;
+			if (end - ptr > 2 && ptr[0] == '0' && (ptr[1] == 'x' || ptr[1] == 'X'))
+			{
+				ptr += 2;
+				while (ptr < end && isIdentifier(*ptr))
+				{
+					auto c = *ptr | 0x20;
+					if (c >= '0' && c <= '9')
+						value = value * 16 + (c - '0');
+					else if (c >= 'a' && c <= 'f')
+						value = value * 16 + (c - 'a' + 10);
+					else if (c != 'u' && c != 'l')
+						error = true;
+					++ptr;
+				}
+			}
+			else
+			{
+				while (ptr < end && isIdentifier(*ptr))
+				{
+					auto c = *ptr;
+					if (c >= '0' && c <= '9')
+						value = value * 10 + (c - '0');
+					else if ((c | 0x20) != 'u' && (c | 0x20) != 'l')
+						error = true;
+					++ptr;
+				}
+			}
+
+			return value;
+		}
+
+		s64 parsePrimary()
+		{
+			ptr = skipSpace(ptr, end);
+			if (ptr == end)
+			{
+				error = true;
+				return 0;
+			}
+
+			if (match("("))
+			{
+				auto value = parseOr();
+				if (!match(")"))
+					error = true;
+
+				return value;
+			}
+
+			if (*ptr >= '0' && *ptr <= '9')
+				return parseNumber();
+
+			auto nameEnd = getIdentifierEnd(ptr, end);
+			if (nameEnd == ptr)
+			{
+				error = true;
+				return 0;
+			}
+
+			if (equals(ptr, nameEnd, "defined"))
+			{
+				ptr = nameEnd;
+				bool parenthesis = match("(");
+
+				ptr = skipSpace(ptr, end);
+				nameEnd = getIdentifierEnd(ptr, end);
+				if (nameEnd == ptr)
+				{
+					error = true;
+					return 0;
+				}
+
+				bool found = preprocessor->findDefine(ptr, static_cast<u32>(nameEnd - ptr), nullptr, nullptr);
+				ptr = nameEnd;
+
+				if (parenthesis && !match(")"))
+					error = true;
+
+				return found ? 1 : 0;
+			}
+
+			const char* value = nullptr;
+			u32 valueSize = 0;
+			bool found = preprocessor->findDefine(ptr, static_cast<u32>(nameEnd - ptr), &value, &valueSize);
+			ptr = nameEnd;
+
+			if (!found)
+				return 0;
+
+			if (valueSize == 0)
+				return 1;
+
+			if (depth == g_maxExpressionDepth)
+			{
+				error = true;
+				return 0;
+			}
+
+			Expression expression = { preprocessor, value, value + valueSize, depth + 1, false };
+			auto result = expression.parseOr();
+			error |= expression.error || skipSpace(expression.ptr, expression.end) != expression.end;
+
+			return result;
+		}
+	};
+}
+
+namespace vx
+{
+	namespace gl
+	{
+		ShaderPreprocessor::ShaderPreprocessor()
+			:m_defines(),
+			m_parameters(),
+			m_includes(),
+			m_included(),
+			m_conditions(),
+			m_source(),
+			m_output(),
+			m_includeDir(),
+			m_outputSize(0),
+			m_globalDefineCount(0),
+			m_sourceStringCount(0)
+		{
+		}
+
+		ShaderPreprocessor::~ShaderPreprocessor()
+		{
+		}
+
+		void ShaderPreprocessor::setIncludeDirectory(const std::string &directory)
+		{
+			m_includeDir = directory;
+			clearIncludeCache();
+		}
+
+		void ShaderPreprocessor::clearIncludeCache()
+		{
+			for (u32 i = 0; i < m_includes.size();)
+			{
+				if (m_includes[i].registered)
+				{
+					++i;
+				}
+				else
+				{
+					m_includes[i] = std::move(m_includes.back());
+					m_includes.pop_back();
+				}
+			}
+		}
+
+		void ShaderPreprocessor::setDefine(const char* define)
+		{
+			m_defines.resize(m_globalDefineCount);
+
+			auto sid = ShaderPreprocessorCpp::hash(define, static_cast<u32>(strlen(define)));
+			for (auto &it : m_defines)
+			{
+				if (it.hash == sid)
+					return;
+			}
+
+			Define entry;
+			entry.hash = sid;
+			entry.value = nullptr;
+			entry.valueSize = 0;
+			m_defines.push_back(entry);
+			++m_globalDefineCount;
+		}
+
+		void ShaderPreprocessor::removeDefine(const char* define)
+		{
+			m_defines.resize(m_globalDefineCount);
+
+			auto sid = ShaderPreprocessorCpp::hash(define, static_cast<u32>(strlen(define)));
+			for (u32 i = 0; i < m_globalDefineCount; ++i)
+			{
+				if (m_defines[i].hash == sid)
+				{
+					m_defines.erase(m_defines.begin() + i);
+					--m_globalDefineCount;
+					return;
+				}
+			}
+		}
+
+		void ShaderPreprocessor::setParameter(const char* name, const char* value)
+		{
+			auto sid = ShaderPreprocessorCpp::hash(name, static_cast<u32>(strlen(name)));
+			for (auto &it : m_parameters)
+			{
+				if (it.hash == sid)
+				{
+					it.value = value;
+					return;
+				}
+			}
+
+			Parameter parameter;
+			parameter.hash = sid;
+			parameter.value = value;
+			m_parameters.push_back(std::move(parameter));
+		}
+
+		bool ShaderPreprocessor::loadIncludeFile(const char* file, const char* key)
+		{
+			std::ifstream inFile(file, std::ios::binary);
+			if (!inFile.is_open())
+			{
+				printf("ShaderPreprocessor: could not open include file '%s'\n", file);
+				return false;
+			}
+
+			std::vector<char> text((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
+
+			auto sid = ShaderPreprocessorCpp::hash(key, static_cast<u32>(strlen(key)));
+			for (auto &it : m_includes)
+			{
+				if (it.hash == sid)
+				{
+					it.text.swap(text);
+					it.registered = true;
+					return true;
+				}
+			}
+
+			Include include;
+			include.hash = sid;
+			include.text.swap(text);
+			include.registered = true;
+			m_includes.push_back(std::move(include));
+
+			return true;
+		}
+
+		bool ShaderPreprocessor::findDefine(const char* name, u32 size, const char** value, u32* valueSize) const
+		{
+			auto sid = ShaderPreprocessorCpp::hash(name, size);
+
+			// later defines of the file override global ones
+			for (auto it = m_defines.rbegin(); it != m_defines.rend(); ++it)
+			{
+				if (it->hash == sid)
+				{
+					if (value)
+						*value = it->value;
+					if (valueSize)
+						*valueSize = it->valueSize;
+
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		const char* ShaderPreprocessor::preprocess(const char* text, u32 size, u32* outSize)
+		{
+			m_defines.resize(m_globalDefineCount);
+			m_included.clear();
+			m_conditions.clear();
+			m_sourceStringCount = 0;
+
+			m_outputSize = 0;
+			if (m_output.size() < size + size / 2 + 1)
+			{
+				m_output.resize(size + size / 2 + 1);
+			}
+
+			bool result = process(text, text + size, 0, 0);
+			m_defines.resize(m_globalDefineCount);
+
+			if (!result)
+				return nullptr;
+
+			write("", 1);
+			*outSize = static_cast<u32>(m_outputSize - 1);
+
+			return m_output.data();
+		}
+
+		const char* ShaderPreprocessor::preprocessFile(const char* file, u32* outSize)
+		{
+			std::ifstream inFile(file, std::ios::binary);
+			if (!inFile.is_open())
+			{
+				printf("ShaderPreprocessor: could not open file '%s'\n", file);
+				return nullptr;
+			}
+
+			inFile.seekg(0, std::ios::end);
+			auto size = static_cast<u32>(inFile.tellg());
+			inFile.seekg(0, std::ios::beg);
+
+			m_source.resize(size);
+			inFile.read(m_source.data(), size);
+
+			auto result = preprocess(m_source.data(), size, outSize);
+			if (!result)
+			{
+				printf("ShaderPreprocessor: error in file '%s'\n", file);
+			}
+
+			return result;
+		}
+
+		bool ShaderPreprocessor::process(const char* ptr, const char* end, u32 depth, u32 sourceString)
+		{
+			auto conditionBase = m_conditions.size();
+
+			u32 line = 1;
+			while (ptr < end)
+			{
+				auto lineEnd = ShaderPreprocessorCpp::findChar(ptr, end, '\n');
+				auto command = ShaderPreprocessorCpp::skipSpace(ptr, lineEnd);
+
+				bool result = true;
+				if (command < lineEnd && *command == '#')
+				{
+					result = processDirective(ptr, command + 1, lineEnd, conditionBase, depth, line, sourceString);
+				}
+				else if (isActive())
+				{
+					result = writeLine(ptr, lineEnd);
+				}
+
+				if (!result)
+				{
+					printf("ShaderPreprocessor: line %u\n", line);
+					return false;
+				}
+
+				// skipped lines stay empty lines
+				if (lineEnd < end)
+				{
+					write("\n", 1);
+				}
+
+				ptr = lineEnd + 1;
+				++line;
+			}
+
+			if (m_conditions.size() != conditionBase)
+			{
+				puts("ShaderPreprocessor: missing #endif");
+				return false;
+			}
+
+			return true;
+		}
+
+		bool ShaderPreprocessor::processDirective(const char* lineBegin, const char* ptr, const char* end, size_t conditionBase, u32 depth, u32 line, u32 sourceString)
+		{
+			auto nameBegin = ShaderPreprocessorCpp::skipSpace(ptr, end);
+			auto nameEnd = ShaderPreprocessorCpp::getIdentifierEnd(nameBegin, end);
+			auto args = ShaderPreprocessorCpp::skipSpace(nameEnd, end);
+
+			// strip line comments and trailing whitespace
+			auto argsEnd = args;
+			for (auto p = args; p < end; ++p)
+			{
+				if (p[0] == '/' && p + 1 < end && p[1] == '/')
+					break;
+
+				if (!ShaderPreprocessorCpp::isSpace(*p))
+					argsEnd = p + 1;
+			}
+
+			auto isDirective = [nameBegin, nameEnd](const char* name)
+			{
+				return ShaderPreprocessorCpp::equals(nameBegin, nameEnd, name);
+			};
+
+			auto evaluate = [this, args, argsEnd](bool* value)
+			{
+				ShaderPreprocessorCpp::Expression expression = { this, args, argsEnd, 0, false };
+				*value = expression.parseOr() != 0;
+				if (expression.error || ShaderPreprocessorCpp::skipSpace(expression.ptr, argsEnd) != argsEnd)
+				{
+					printf("ShaderPreprocessor: invalid expression '%.*s'\n", static_cast<int>(argsEnd - args), args);
+					return false;
+				}
+
+				return true;
+			};
+
+			bool active = isActive();
+
+			bool isIfdef = isDirective("ifdef");
+			bool isIfndef = isDirective("ifndef");
+			if (isIfdef || isIfndef || isDirective("if"))
+			{
+				bool value = false;
+				if (active)
+				{
+					if (isIfdef || isIfndef)
+					{
+						auto identifierEnd = ShaderPreprocessorCpp::getIdentifierEnd(args, argsEnd);
+						if (identifierEnd == args)
+						{
+							puts("ShaderPreprocessor: expected identifier");
+							return false;
+						}
+
+						value = findDefine(args, static_cast<u32>(identifierEnd - args), nullptr, nullptr) == isIfdef;
+					}
+					else if (!evaluate(&value))
+					{
+						return false;
+					}
+				}
+
+				Condition condition;
+				condition.active = active && value;
+				condition.parentActive = active;
+				condition.taken = condition.active;
+				condition.hasElse = false;
+				m_conditions.push_back(condition);
+
+				return true;
+			}
+
+			bool isElif = isDirective("elif");
+			bool isElse = isDirective("else");
+			if (isElif || isElse)
+			{
+				if (m_conditions.size() <= conditionBase || m_conditions.back().hasElse)
+				{
+					puts("ShaderPreprocessor: #else or #elif without #if");
+					return false;
+				}
+
+				auto &condition = m_conditions.back();
+				if (isElse)
+				{
+					condition.active = condition.parentActive && !condition.taken;
+					condition.hasElse = true;
+				}
+				else if (condition.parentActive && !condition.taken)
+				{
+					bool value = false;
+					if (!evaluate(&value))
+						return false;
+
+					condition.active = value;
+				}
+				else
+				{
+					condition.active = false;
+				}
+				condition.taken |= condition.active;
+
+				return true;
+			}
+
+			if (isDirective("endif"))
+			{
+				if (m_conditions.size() <= conditionBase)
+				{
+					puts("ShaderPreprocessor: #endif without #if");
+					return false;
+				}
+
+				m_conditions.pop_back();
+				return true;
+			}
+
+			if (!active)
+				return true;
+
+			if (isDirective("include"))
+				return processInclude(args, argsEnd, depth, line, sourceString);
+
+			bool isDefine = isDirective("define");
+			if (isDefine || isDirective("undef"))
+			{
+				auto identifierEnd = ShaderPreprocessorCpp::getIdentifierEnd(args, argsEnd);
+				if (identifierEnd == args)
+				{
+					puts("ShaderPreprocessor: expected identifier");
+					return false;
+				}
+
+				auto sid = ShaderPreprocessorCpp::hash(args, static_cast<u32>(identifierEnd - args));
+				for (auto i = m_globalDefineCount; i < m_defines.size(); ++i)
+				{
+					if (m_defines[i].hash == sid)
+					{
+						m_defines.erase(m_defines.begin() + i);
+						break;
+					}
+				}
+
+				if (isDefine)
+				{
+					auto value = ShaderPreprocessorCpp::skipSpace(identifierEnd, argsEnd);
+
+					Define define;
+					define.hash = sid;
+					define.value = value;
+					define.valueSize = static_cast<u32>(argsEnd - value);
+					m_defines.push_back(define);
+				}
+			}
+
+			// everything except includes and conditions is also seen by the compiler
+			write(lineBegin, end - lineBegin);
+
+			return true;
+		}
+
+		bool ShaderPreprocessor::processInclude(const char* ptr, const char* end, u32 depth, u32 line, u32 sourceString)
+		{
+			if (ptr == end || (*ptr != '"' && *ptr != '<'))
+			{
+				puts("ShaderPreprocessor: expected include file");
+				return false;
+			}
+
+			auto nameBegin = ptr + 1;
+			auto nameEnd = ShaderPreprocessorCpp::findChar(nameBegin, end, (*ptr == '"') ? '"' : '>');
+			if (nameEnd == end)
+			{
+				puts("ShaderPreprocessor: expected include file");
+				return false;
+			}
+
+			if (depth + 1 == ShaderPreprocessorCpp::g_maxIncludeDepth)
+			{
+				puts("ShaderPreprocessor: includes nested too deep");
+				return false;
+			}
+
+			auto size = static_cast<u32>(nameEnd - nameBegin);
+			auto sid = ShaderPreprocessorCpp::hash(nameBegin, size);
+			for (auto it : m_included)
+			{
+				if (it == sid)
+					return true;
+			}
+			m_included.push_back(sid);
+
+			const char* text = nullptr;
+			u32 textSize = 0;
+			if (!getInclude(nameBegin, size, &text, &textSize))
+			{
+				printf("ShaderPreprocessor: could not open include file '%.*s'\n", static_cast<int>(size), nameBegin);
+				return false;
+			}
+
+			char lineDirective[32];
+			auto includeSourceString = ++m_sourceStringCount;
+			auto length = snprintf(lineDirective, sizeof(lineDirective), "#line 1 %u\n", includeSourceString);
+			write(lineDirective, length);
+
+			if (!process(text, text + textSize, depth + 1, includeSourceString))
+				return false;
+
+			// continue with the line after the #include, its newline is written by the caller
+			if (m_output[m_outputSize - 1] != '\n')
+			{
+				write("\n", 1);
+			}
+
+			length = snprintf(lineDirective, sizeof(lineDirective), "#line %u %u", line + 1, sourceString);
+			write(lineDirective, length);
+
+			return true;
+		}
+
+		bool ShaderPreprocessor::getInclude(const char* name, u32 size, const char** text, u32* textSize)
+		{
+			auto sid = ShaderPreprocessorCpp::hash(name, size);
+			for (auto &it : m_includes)
+			{
+				if (it.hash == sid)
+				{
+					*text = it.text.data();
+					*textSize = static_cast<u32>(it.text.size());
+					return true;
+				}
+			}
+
+			auto file = m_includeDir;
+			file.append(name, size);
+
+			std::ifstream inFile(file.c_str(), std::ios::binary);
+			if (!inFile.is_open())
+				return false;
+
+			Include include;
+			include.hash = sid;
+			include.text.assign(std::istreambuf_iterator<char>(inFile), std::istreambuf_iterator<char>());
+			include.registered = false;
+
+			*text = include.text.data();
+			*textSize = static_cast<u32>(include.text.size());
+			m_includes.push_back(std::move(include));
+
+			return true;
+		}
+
+		bool ShaderPreprocessor::writeLine(const char* ptr, const char* end)
+		{
+			while (true)
+			{
+				auto marker = ShaderPreprocessorCpp::findChar(ptr, end, '$');
+				write(ptr, marker - ptr);
+				if (marker == end)
+					return true;
+
+				auto nameBegin = marker + 1;
+				auto nameEnd = ShaderPreprocessorCpp::findChar(nameBegin, end, '$');
+				if (nameEnd == end)
+				{
+					puts("ShaderPreprocessor: unterminated parameter");
+					return false;
+				}
+
+				auto sid = ShaderPreprocessorCpp::hash(nameBegin, static_cast<u32>(nameEnd - nameBegin));
+				const Parameter* parameter = nullptr;
+				for (auto &it : m_parameters)
+				{
+					if (it.hash == sid)
+					{
+						parameter = &it;
+						break;
+					}
+				}
+
+				if (!parameter)
+				{
+					printf("ShaderPreprocessor: could not find value for parameter '%.*s'\n", static_cast<int>(nameEnd - nameBegin), nameBegin);
+					return false;
+				}
+
+				write(parameter->value.c_str(), parameter->value.size());
+				ptr = nameEnd + 1;
+			}
+		}
+
+		void ShaderPreprocessor::write(const char* ptr, size_t size)
+		{
+			if (m_outputSize + size > m_output.size())
+			{
+				m_output.resize(std::max(m_output.size() * 2, m_outputSize + size));
+			}
+
+			memcpy(m_output.data() + m_outputSize, ptr, size);
+			m_outputSize += size;
+		}
+
+		bool ShaderPreprocessor::isActive() const
+		{
+			return m_conditions.empty() || m_conditions.back().active;
+		}
+	}
+}
\ No newline at end of file
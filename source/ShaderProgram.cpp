@@ -30,12 +30,14 @@ namespace vx
 	{
 		ShaderProgram::ShaderProgram(ShaderProgramType type)
 			:Base(),
+			m_reflection(),
 			m_type(type)
 		{
 		}
 
 		ShaderProgram::ShaderProgram(ShaderProgram &&rhs) noexcept
 			: Base(std::move(rhs)),
+			m_reflection(std::move(rhs.m_reflection)),
 			m_type(rhs.m_type)
 		{
 		}
@@ -50,6 +52,7 @@ namespace vx
 			if (this != &rhs)
 			{
 				MyBase::operator=(std::move(rhs));
+				std::swap(m_reflection, rhs.m_reflection);
 				std::swap(m_type, rhs.m_type);
 			}
 
@@ -94,26 +97,101 @@ namespace vx
 
 			if (m_id == 0)
 			{
-				auto type = detail::getShaderProgramType(m_type);
-				m_id = glCreateShaderProgramv(type, 1, program);
-				if (m_id == 0)
+				if (!submit(program))
 					return log;
 
-				if (!checkLinkStatus() || !checkValidateStatuts())
-				{
-					log = getProgramInfoLog(&logLength);
-				}
+				log = finish(logLength);
 			}
 
 			return log;
 		}
 
+		bool ShaderProgram::submit(const char **program)
+		{
+			if (m_id != 0)
+				return false;
+
+			auto type = detail::getShaderProgramType(m_type);
+			m_id = glCreateShaderProgramv(type, 1, program);
+
+			return (m_id != 0);
+		}
+
+		bool ShaderProgram::isCompileComplete() const
+		{
+			if (!FLEXT_KHR_parallel_shader_compile || m_id == 0)
+				return true;
+
+			s32 complete = GL_FALSE;
+			glGetProgramiv(m_id, GL_COMPLETION_STATUS_KHR, &complete);
+
+			return (complete == GL_TRUE);
+		}
+
+		std::unique_ptr<char[]> ShaderProgram::finish(s32 &logLength)
+		{
+			std::unique_ptr<char[]> log;
+
+			if (m_id != 0 && (!checkLinkStatus() || !checkValidateStatuts()))
+			{
+				log = getProgramInfoLog(&logLength);
+			}
+			else if (m_id != 0)
+			{
+				m_reflection.create(m_id);
+			}
+
+			return log;
+		}
+
+		bool ShaderProgram::createFromBinary(u32 binaryFormat, const void* binary, s32 size)
+		{
+			if (m_id != 0)
+				return false;
+
+			m_id = glCreateProgram();
+			glProgramParameteri(m_id, GL_PROGRAM_SEPARABLE, GL_TRUE);
+			glProgramBinary(m_id, binaryFormat, binary, size);
+
+			if (!checkLinkStatus())
+			{
+				destroy();
+				return false;
+			}
+
+			m_reflection.create(m_id);
+
+			return true;
+		}
+
+		std::unique_ptr<u8[]> ShaderProgram::getBinary(u32* binaryFormat, s32* size) const
+		{
+			std::unique_ptr<u8[]> binary;
+
+			s32 length = 0;
+			glGetProgramiv(m_id, GL_PROGRAM_BINARY_LENGTH, &length);
+			if (length <= 0)
+				return binary;
+
+			binary = std::unique_ptr<u8[]>(new u8[length]);
+
+			GLenum format = 0;
+			glGetProgramBinary(m_id, length, size, &format, binary.get());
+			*binaryFormat = format;
+
+			if (*size <= 0)
+				binary.reset();
+
+			return binary;
+		}
+
 		void ShaderProgram::destroy()
 		{
 			if (m_id != 0)
 			{
 				glDeleteProgram(m_id);
 				m_id = 0;
+				m_reflection.clear();
 			}
 		}
 	}
@@ -0,0 +1,107 @@
+/*
+The MIT License(MIT)
+
+Copyright(c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/ShaderSourceCache.h>
+#include <vxGL/CacheFile.h>
+#include <Windows.h>
+#include <cstdio>
+
+namespace ShaderSourceCacheCpp
+{
+	const u32 g_magic = 0x53505856; // 'VXPS'
+	const u32 g_version = 2;
+}
+
+namespace vx
+{
+	namespace gl
+	{
+		ShaderSourceCache::ShaderSourceCache()
+			:m_sources(),
+			m_directory()
+		{
+		}
+
+		ShaderSourceCache::~ShaderSourceCache()
+		{
+		}
+
+		void ShaderSourceCache::initialize(const std::string &directory)
+		{
+			m_directory = directory;
+			if (!m_directory.empty())
+			{
+				CreateDirectoryA(m_directory.c_str(), nullptr);
+			}
+		}
+
+		void ShaderSourceCache::clear()
+		{
+			m_sources.clear();
+		}
+
+		std::string ShaderSourceCache::getFileName(u64 key) const
+		{
+			char buffer[32];
+			snprintf(buffer, sizeof(buffer), "%016llx.src", static_cast<unsigned long long>(key));
+
+			return m_directory + buffer;
+		}
+
+		bool ShaderSourceCache::find(u64 key, std::string* source)
+		{
+			auto it = m_sources.find(key);
+			if (it != m_sources.end())
+			{
+				*source = *it;
+				return true;
+			}
+
+			if (m_directory.empty())
+				return false;
+
+			std::string data;
+			if (!readCacheFile(getFileName(key), ShaderSourceCacheCpp::g_magic, ShaderSourceCacheCpp::g_version, key, &data))
+				return false;
+
+			*source = data;
+			m_sources.insert(std::move(key), std::move(data));
+
+			return true;
+		}
+
+		void ShaderSourceCache::insert(u64 key, const std::string &source)
+		{
+			if (m_sources.find(key) != m_sources.end())
+				return;
+
+			m_sources.insert(u64(key), std::string(source));
+
+			if (m_directory.empty())
+				return;
+
+			writeCacheFile(getFileName(key), ShaderSourceCacheCpp::g_magic, ShaderSourceCacheCpp::g_version, key, source.data(), source.size());
+		}
+	}
+}
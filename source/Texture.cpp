@@ -22,409 +22,15 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 #include <vxGL/Texture.h>
+#include <vxGL/TextureReadback.h>
 #include <vxGL/gl.h>
 #include <cstdio>
+#include <memory>
 
 namespace vx
 {
 	namespace gl
 	{
-		void getTextureFormat(TextureFormat textureFormat, u32 &format, u32 &internalFormat, bool* compressed)
-		{
-			format = 0;
-			internalFormat = 0;
-			*compressed = false;
-
-			switch (textureFormat)
-			{
-			case TextureFormat::R8:
-			{
-				format = GL_RED;
-				internalFormat = GL_R8;
-			}break;
-			case TextureFormat::R8S:
-			{
-				format = GL_RED;
-				internalFormat = GL_R8_SNORM;
-			}break;
-			case TextureFormat::R16:
-			{
-				format = GL_RED;
-				internalFormat = GL_R16;
-			}break;
-			case TextureFormat::R16S:
-			{
-				internalFormat = GL_R16_SNORM;
-				format = GL_RED;
-			}break;
-			case TextureFormat::RG8:
-			{
-				internalFormat = GL_RGB8;
-				format = GL_RG;
-			}break;
-			case TextureFormat::RG8S:
-			{
-				internalFormat = GL_RG8_SNORM;
-				format = GL_RG;
-			}break;
-			case TextureFormat::RG16:
-			{
-				internalFormat = GL_RGB16;
-				format = GL_RG;
-			}break;
-			case TextureFormat::RG16S:
-			{
-				internalFormat = GL_RGB16_SNORM;
-				format = GL_RG;
-			}break;
-			case TextureFormat::RGB4:
-			{
-				internalFormat = GL_RGB4;
-				format = GL_RGB;
-			}break;
-			case TextureFormat::RGB5:
-			{
-				internalFormat = GL_RGB5;
-				format = GL_RGB;
-			}break;
-			case TextureFormat::RGB8:
-			{
-				internalFormat = GL_RGB8;
-				format = GL_RGB;
-			}break;
-			case TextureFormat::RGB8S:
-			{
-				internalFormat = GL_RGB8_SNORM;
-				format = GL_RGB;
-			}break;
-			case TextureFormat::RGB10:
-			{
-				internalFormat = GL_RGB10;
-				format = GL_RGB;
-			}break;
-			case TextureFormat::RGB12:
-			{
-				internalFormat = GL_RGB12;
-				format = GL_RGB;
-			}break;
-			case TextureFormat::RGB16S:
-			{
-				internalFormat = GL_RGB16_SNORM;
-				format = GL_RGB;
-			}break;
-			case TextureFormat::RGBA2:
-			{
-				internalFormat = GL_RGBA2;
-				format = GL_RGBA;
-			}break;
-			case TextureFormat::RGBA4:
-			{
-				internalFormat = GL_RGBA4;
-				format = GL_RGBA;
-			}break;
-			case TextureFormat::RGB5A1:
-			{
-				internalFormat = GL_RGB5_A1;
-				format = GL_RGBA;
-			}break;
-			case TextureFormat::RGBA8:
-			{
-				internalFormat = GL_RGBA8;
-				format = GL_RGBA;
-			}break;
-			case TextureFormat::RGBA8S:
-			{
-				internalFormat = GL_RGBA8_SNORM;
-				format = GL_RGBA;
-			}break;
-			case TextureFormat::RGB10A2:
-			{
-				format = GL_RGB;
-				internalFormat = GL_RGB10_A2;
-			}break;
-			case TextureFormat::RGB10A2UI:
-			{
-				format = GL_RGBA;
-				internalFormat = GL_RGB10_A2UI;
-			}break;
-			case TextureFormat::RGBA12:
-			{
-				internalFormat = GL_RGBA12;
-				format = GL_RGBA;
-			}break;
-			case TextureFormat::RGBA16:
-			{
-				internalFormat = GL_RGBA16;
-				format = GL_RGBA;
-			}break;
-			case TextureFormat::SRGB8:
-			{
-				format = GL_RGB;
-				internalFormat = GL_SRGB8;
-			}break;
-			case TextureFormat::SRGBA8:
-			{
-				format = GL_RGBA;
-				internalFormat = GL_SRGB8_ALPHA8;
-			}break;
-			case TextureFormat::RGB_DXT1:
-			{
-				format = GL_RGB;
-				internalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
-				*compressed = true;
-			}break;
-			case TextureFormat::RGBA_DXT1:
-			{
-				format = GL_RGBA;
-				internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
-				*compressed = true;
-			}break;
-			case TextureFormat::RGBA_DXT3:
-			{
-				format = GL_RGBA;
-				internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
-				*compressed = true;
-			}break;
-			case TextureFormat::RGBA_DXT5:
-			{
-				format = GL_RGBA;
-				internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
-				*compressed = true;
-			}break;
-			case TextureFormat::SRGB_DXT1:
-			{
-				format = GL_RGB;
-				internalFormat = GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
-				*compressed = true;
-			}break;
-			case TextureFormat::SRGBA_DXT1:
-			{
-				format = GL_RGBA;
-				internalFormat = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
-				*compressed = true;
-			}break;
-			case TextureFormat::SRGBA_DXT3:
-			{
-				format = GL_RGBA;
-				internalFormat = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
-				*compressed = true;
-			}break;
-			case TextureFormat::SRGBA_DXT5:
-			{
-				format = GL_RGBA;
-				internalFormat = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
-				*compressed = true;
-			}break;
-			case TextureFormat::RGB_BC6UF:
-			{
-				format = GL_RGB;
-				internalFormat = GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;
-				*compressed = true;
-			}break;
-			case TextureFormat::RGB_BC6F:
-			{
-				format = GL_RGB;
-				internalFormat = GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT;
-				*compressed = true;
-			}break;
-			case TextureFormat::RGBA_BC7:
-			{
-				format = GL_RGBA;
-				internalFormat = GL_COMPRESSED_RGBA_BPTC_UNORM;
-				*compressed = true;
-			}break;
-			case TextureFormat::SRGBA_BC7:
-			{
-				format = GL_RGBA;
-				internalFormat = GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
-				*compressed = true;
-			}break;
-			case TextureFormat::R16F:
-			{
-				format = GL_RED;
-				internalFormat = GL_R16F;
-			}break;
-			case TextureFormat::RG16F:
-			{
-				format = GL_RG;
-				internalFormat = GL_RG16F;
-			}break;
-			case TextureFormat::RGB16F:
-			{
-				format = GL_RGB;
-				internalFormat = GL_RGB16F;
-			}break;
-			case TextureFormat::RGBA16F:
-			{
-				format = GL_RGBA;
-				internalFormat = GL_RGBA16F;
-			}break;
-			case TextureFormat::R32F:
-			{
-				format = GL_RED;
-				internalFormat = GL_R32F;
-			}break;
-			case TextureFormat::RG32F:
-			{
-				format = GL_RG;
-				internalFormat = GL_RG32F;
-			}break;
-			case TextureFormat::RGB32F:
-			{
-				format = GL_RGB;
-				internalFormat = GL_RGB32F;
-			}break;
-			case TextureFormat::RGBA32F:
-			{
-				format = GL_RGBA;
-				internalFormat = GL_RGBA32F;
-			}break;
-			case TextureFormat::R8I:
-			{
-				format = GL_RED;
-				internalFormat = GL_R8I;
-			}break;
-			case TextureFormat::R8UI:
-			{
-				format = GL_RED;
-				internalFormat = GL_R8UI;
-			}break;
-			case TextureFormat::R16I:
-			{
-				format = GL_RED;
-				internalFormat = GL_R16I;
-			}break;
-			case TextureFormat::R16UI:
-			{
-				format = GL_RED;
-				internalFormat = GL_R16UI;
-			}break;
-			case TextureFormat::R32I:
-			{
-				format = GL_RED;
-				internalFormat = GL_R32I;
-			}break;
-			case TextureFormat::R32UI:
-			{
-				format = GL_RED;
-				internalFormat = GL_R32UI;
-			}break;
-			case TextureFormat::RG8I:
-			{
-				internalFormat = GL_RG8I;
-				format = GL_RG;
-			}break;
-			case TextureFormat::RG8UI:
-			{
-				internalFormat = GL_RG8UI;
-				format = GL_RG;
-			}break;
-			case TextureFormat::RG16I:
-			{
-				internalFormat = GL_RG16I;
-				format = GL_RG;
-			}break;
-			case TextureFormat::RG16UI:
-			{
-				internalFormat = GL_RG16UI;
-				format = GL_RG;
-			}break;
-			case TextureFormat::RG32I:
-			{
-				internalFormat = GL_RG32I;
-				format = GL_RG;
-			}break;
-			case TextureFormat::RG32UI:
-			{
-				internalFormat = GL_RG32UI;
-				format = GL_RG;
-			}break;
-			case TextureFormat::RGB8I:
-			{
-				internalFormat = GL_RGB8I;
-				format = GL_RGB;
-			}break;
-			case TextureFormat::RGB8UI:
-			{
-				internalFormat = GL_RGB8UI;
-				format = GL_RGB;
-			}break;
-			case TextureFormat::RGB16I:
-			{
-				internalFormat = GL_RGB16I;
-				format = GL_RGB;
-			}break;
-			case TextureFormat::RGB16UI:
-			{
-				internalFormat = GL_RGB16UI;
-				format = GL_RGB;
-			}break;
-			case TextureFormat::RGB32I:
-			{
-				internalFormat = GL_RGB32I;
-				format = GL_RGB;
-			}break;
-			case TextureFormat::RGB32UI:
-			{
-				internalFormat = GL_RGB32UI;
-				format = GL_RGB;
-			}break;
-			case TextureFormat::RGBA8I:
-			{
-				internalFormat = GL_RGBA8I;
-				format = GL_RGBA;
-			}break;
-			case TextureFormat::RGBA8UI:
-			{
-				internalFormat = GL_RGBA8UI;
-				format = GL_RGBA;
-			}break;
-			case TextureFormat::RGBA16I:
-			{
-				internalFormat = GL_RGBA16I;
-				format = GL_RGBA;
-			}break;
-			case TextureFormat::RGBA16UI:
-			{
-				internalFormat = GL_RGBA16UI;
-				format = GL_RGBA;
-			}break;
-			case TextureFormat::RGBA32I:
-			{
-				internalFormat = GL_RGBA32I;
-				format = GL_RGBA;
-			}break;
-			case TextureFormat::RGBA32UI:
-			{
-				internalFormat = GL_RGBA32UI;
-				format = GL_RGBA;
-			}break;
-			case TextureFormat::DEPTH16:
-			{
-				internalFormat = GL_DEPTH_COMPONENT16;
-				format = GL_DEPTH_COMPONENT;
-			}break;
-			case TextureFormat::DEPTH24:
-			{
-				internalFormat = GL_DEPTH_COMPONENT24;
-				format = GL_DEPTH_COMPONENT;
-			}break;
-			case TextureFormat::DEPTH32:
-			{
-				internalFormat = GL_DEPTH_COMPONENT32;
-				format = GL_DEPTH_COMPONENT;
-			}break;
-			case TextureFormat::DEPTH32F:
-			{
-				internalFormat = GL_DEPTH_COMPONENT32F;
-				format = GL_DEPTH_COMPONENT;
-			}break;
-			default:
-				VX_ASSERT(false);
-				break;
-			}
-		}
-
 		namespace detail
 		{
 			u32 getTarget(TextureType type)
@@ -467,6 +73,97 @@ namespace vx
 				return target;
 			}
 
+			// returns 0 for formats that can not be used with texture views
+			u32 getViewClass(TextureFormat format)
+			{
+				auto &traits = getTextureFormatTraits(format);
+				if (traits.depth != 0)
+				{
+					// depth formats are only compatible with themselves
+					return traits.internalFormat;
+				}
+
+				switch (traits.internalFormat)
+				{
+				case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+				case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+					return GL_VIEW_CLASS_S3TC_DXT1_RGB;
+				case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+				case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT:
+					return GL_VIEW_CLASS_S3TC_DXT1_RGBA;
+				case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+				case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT:
+					return GL_VIEW_CLASS_S3TC_DXT3_RGBA;
+				case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+				case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+					return GL_VIEW_CLASS_S3TC_DXT5_RGBA;
+				case GL_COMPRESSED_RGBA_BPTC_UNORM:
+				case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+					return GL_VIEW_CLASS_BPTC_UNORM;
+				case GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT:
+				case GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT:
+					return GL_VIEW_CLASS_BPTC_FLOAT;
+				// legacy formats without a sized storage class
+				case GL_RGB4:
+				case GL_RGB5:
+				case GL_RGB10:
+				case GL_RGB12:
+				case GL_RGBA2:
+				case GL_RGBA4:
+				case GL_RGB5_A1:
+				case GL_RGBA12:
+					return 0;
+				default:
+					break;
+				}
+
+				switch (traits.bytesPerBlock)
+				{
+				case 1:
+					return GL_VIEW_CLASS_8_BITS;
+				case 2:
+					return GL_VIEW_CLASS_16_BITS;
+				case 3:
+					return GL_VIEW_CLASS_24_BITS;
+				case 4:
+					return GL_VIEW_CLASS_32_BITS;
+				case 6:
+					return GL_VIEW_CLASS_48_BITS;
+				case 8:
+					return GL_VIEW_CLASS_64_BITS;
+				case 12:
+					return GL_VIEW_CLASS_96_BITS;
+				case 16:
+					return GL_VIEW_CLASS_128_BITS;
+				default:
+					return 0;
+				}
+			}
+
+			bool isViewTargetCompatible(u32 sourceTarget, u32 viewTarget)
+			{
+				switch (sourceTarget)
+				{
+				case GL_TEXTURE_1D:
+				case GL_TEXTURE_1D_ARRAY:
+					return viewTarget == GL_TEXTURE_1D || viewTarget == GL_TEXTURE_1D_ARRAY;
+				case GL_TEXTURE_2D:
+					return viewTarget == GL_TEXTURE_2D || viewTarget == GL_TEXTURE_2D_ARRAY;
+				case GL_TEXTURE_3D:
+					return viewTarget == GL_TEXTURE_3D;
+				case GL_TEXTURE_CUBE_MAP:
+				case GL_TEXTURE_2D_ARRAY:
+				case GL_TEXTURE_CUBE_MAP_ARRAY:
+					return viewTarget == GL_TEXTURE_2D || viewTarget == GL_TEXTURE_2D_ARRAY ||
+						viewTarget == GL_TEXTURE_CUBE_MAP || viewTarget == GL_TEXTURE_CUBE_MAP_ARRAY;
+				case GL_TEXTURE_2D_MULTISAMPLE:
+				case GL_TEXTURE_2D_MULTISAMPLE_ARRAY:
+					return viewTarget == GL_TEXTURE_2D_MULTISAMPLE || viewTarget == GL_TEXTURE_2D_MULTISAMPLE_ARRAY;
+				default:
+					return false;
+				}
+			}
+
 			void subImage2D
 				(
 				u32 id,
@@ -591,6 +288,8 @@ namespace vx
 			m_format(0),
 			m_internalFormat(0),
 			m_size(),
+			m_miplevels(0),
+			m_textureFormat(),
 			m_formatData(),
 			m_compressed(0)
 		{
@@ -602,6 +301,8 @@ namespace vx
 			m_format(rhs.m_format),
 			m_internalFormat(rhs.m_internalFormat),
 			m_size(rhs.m_size),
+			m_miplevels(rhs.m_miplevels),
+			m_textureFormat(rhs.m_textureFormat),
 			m_formatData(std::move(rhs.m_formatData)),
 			m_compressed(rhs.m_compressed)
 		{
@@ -621,6 +322,8 @@ namespace vx
 				m_format = rhs.m_format;
 				m_internalFormat = rhs.m_internalFormat;
 				m_size = rhs.m_size;
+				m_miplevels = rhs.m_miplevels;
+				m_textureFormat = rhs.m_textureFormat;
 				m_formatData = rhs.m_formatData;
 				m_compressed = rhs.m_compressed;
 			}
@@ -674,11 +377,13 @@ namespace vx
 			{
 				m_target = ::vx::gl::detail::getTarget(desc.type);
 				m_size = desc.size;
+				m_miplevels = desc.miplevels;
+				m_textureFormat = desc.format;
 
-				bool compressed;
-				getTextureFormat(desc.format, m_format, m_internalFormat, &compressed);
-
-				m_compressed = (u8)compressed;
+				auto &traits = getTextureFormatTraits(desc.format);
+				m_format = traits.format;
+				m_internalFormat = traits.internalFormat;
+				m_compressed = traits.compressed;
 
 				glCreateTextures(m_target, 1, &m_id);
 
@@ -726,6 +431,71 @@ namespace vx
 			}
 		}
 
+		bool Texture::createView(const Texture &source, TextureType type, TextureFormat format, u32 minLevel, u32 numLevels, u32 minLayer, u32 numLayers)
+		{
+			if (m_id != 0 || !source.isValid())
+				return false;
+
+			auto target = ::vx::gl::detail::getTarget(type);
+			if (!detail::isViewTargetCompatible(source.m_target, target))
+			{
+				printf("Texture::createView: target not compatible\n");
+				return false;
+			}
+
+			auto viewClass = detail::getViewClass(format);
+			if (viewClass == 0 || viewClass != detail::getViewClass(source.m_textureFormat))
+			{
+				printf("Texture::createView: format not compatible\n");
+				return false;
+			}
+
+			auto &traits = getTextureFormatTraits(format);
+
+			// views need a name that has never been bound
+			glGenTextures(1, &m_id);
+			glTextureView(m_id, target, source.m_id, traits.internalFormat, minLevel, numLevels, minLayer, numLayers);
+
+			m_target = target;
+			m_format = traits.format;
+			m_internalFormat = traits.internalFormat;
+			m_textureFormat = format;
+			m_compressed = traits.compressed;
+			m_miplevels = (u16)numLevels;
+
+			m_size.x = std::max(source.m_size.x >> minLevel, 1);
+			m_size.y = std::max(source.m_size.y >> minLevel, 1);
+			m_size.z = (type == TextureType::Texture_3D) ? std::max(source.m_size.z >> minLevel, 1) : numLayers;
+			if (source.m_target == GL_TEXTURE_2D_MULTISAMPLE || source.m_target == GL_TEXTURE_2D_MULTISAMPLE_ARRAY)
+			{
+				m_miplevels = source.m_miplevels;
+			}
+
+			m_formatData = vx::bitset<8>();
+			if (source.isSparseTexture())
+			{
+				m_formatData.set<0>();
+			}
+			m_formatData.set<4>();
+
+			switch (type)
+			{
+			case gl::TextureType::Texture_1D:
+			case gl::TextureType::Texture_1D_Array:
+				m_formatData.set<1>();
+				break;
+			case gl::TextureType::Texture_3D:
+			case gl::TextureType::Texture_Cubemap_Array:
+				m_formatData.set<3>();
+				break;
+			default:
+				m_formatData.set<2>();
+				break;
+			}
+
+			return true;
+		}
+
 		void Texture::destroy()
 		{
 			if (m_id != 0)
@@ -769,6 +539,79 @@ namespace vx
 			}
 		}
 
+		void Texture::subImageBatch(const TextureSubImageDescription* descs, u32 count) const
+		{
+			VX_ASSERT(!isCompressed());
+
+			if (count == 0)
+				return;
+
+			// data is expected to be tightly packed, the caller's GL_UNPACK_ALIGNMENT is restored afterwards
+			s32 unpackAlignment = 4;
+			glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpackAlignment);
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+			bool layered = (m_target == GL_TEXTURE_2D_ARRAY || m_target == GL_TEXTURE_CUBE_MAP || m_target == GL_TEXTURE_CUBE_MAP_ARRAY);
+			if (!layered)
+			{
+				for (u32 i = 0; i < count; ++i)
+				{
+					subImage(descs[i]);
+				}
+			}
+			else
+			{
+				auto indices = std::unique_ptr<u32[]>(new u32[count]);
+				for (u32 i = 0; i < count; ++i)
+				{
+					indices[i] = i;
+				}
+
+				std::sort(indices.get(), indices.get() + count, [descs](u32 l, u32 r)
+				{
+					auto &descL = descs[l];
+					auto &descR = descs[r];
+					if (descL.miplevel != descR.miplevel)
+						return descL.miplevel < descR.miplevel;
+
+					return descL.offset.z < descR.offset.z;
+				});
+
+				u32 i = 0;
+				while (i < count)
+				{
+					auto &first = descs[indices[i]];
+					auto layerSize = (u64)getPixelSize(m_textureFormat, first.dataType) * first.size.x * first.size.y * first.size.z;
+					auto layerCount = first.size.z;
+
+					auto next = i + 1;
+					while (next < count)
+					{
+						auto &desc = descs[indices[next]];
+						auto expected = (const u8*)first.p + layerSize * (next - i);
+						bool contiguous = desc.miplevel == first.miplevel &&
+							desc.offset.x == first.offset.x && desc.offset.y == first.offset.y &&
+							desc.size.x == first.size.x && desc.size.y == first.size.y && desc.size.z == first.size.z &&
+							desc.offset.z == first.offset.z + layerCount &&
+							desc.dataType == first.dataType &&
+							desc.p == expected;
+
+						if (!contiguous)
+							break;
+
+						layerCount += desc.size.z;
+						++next;
+					}
+
+					vx::gl::detail::subImage3D(m_id, first.miplevel, first.offset.x, first.offset.y, first.offset.z, first.size.x, first.size.y, layerCount, m_format, first.dataType, first.p);
+
+					i = next;
+				}
+			}
+
+			glPixelStorei(GL_UNPACK_ALIGNMENT, unpackAlignment);
+		}
+
 		void Texture::subImageCompressed(const TextureCompressedSubImageDescription &desc) const
 		{
 			bool compressed = isCompressed();
@@ -806,6 +649,11 @@ namespace vx
 			glTexturePageCommitmentEXT(m_id, desc.miplevel, desc.offset.x, desc.offset.y, desc.offset.z, desc.size.x, desc.size.y, desc.size.z, desc.commit);
 		}
 
+		bool Texture::readback(u32 level, u32 layer, TextureReadback* result) const
+		{
+			return result->request(*this, level, layer);
+		}
+
 		void Texture::setWrapMode1D(TextureWrapMode wrap_s) const
 		{
 			auto s = detail::getTextureWrapMode(wrap_s);
@@ -896,6 +744,77 @@ namespace vx
 			return m_target;
 		}
 
+		u32 Texture::getFormat() const
+		{
+			return m_format;
+		}
+
+		u32 Texture::getInternalFormat() const
+		{
+			return m_internalFormat;
+		}
+
+		TextureFormat Texture::getTextureFormat() const
+		{
+			return m_textureFormat;
+		}
+
+		u16 Texture::getMipLevels() const
+		{
+			return (m_target == GL_TEXTURE_2D_MULTISAMPLE || m_target == GL_TEXTURE_2D_MULTISAMPLE_ARRAY) ? 1 : m_miplevels;
+		}
+
+		u64 Texture::getMemorySize() const
+		{
+			// views share the storage of their source
+			if (m_id == 0 || isView())
+				return 0;
+
+			u32 layers = 1;
+			u32 samples = 1;
+			u32 levels = m_miplevels;
+			bool mipDepth = false;
+			switch (m_target)
+			{
+			case GL_TEXTURE_2D_ARRAY:
+			case GL_TEXTURE_CUBE_MAP_ARRAY:
+				layers = m_size.z;
+				break;
+			case GL_TEXTURE_1D_ARRAY:
+				layers = m_size.y;
+				break;
+			case GL_TEXTURE_CUBE_MAP:
+				layers = 6;
+				break;
+			case GL_TEXTURE_3D:
+				mipDepth = true;
+				break;
+			case GL_TEXTURE_2D_MULTISAMPLE:
+				samples = m_miplevels;
+				levels = 1;
+				break;
+			case GL_TEXTURE_2D_MULTISAMPLE_ARRAY:
+				samples = m_miplevels;
+				layers = m_size.z;
+				levels = 1;
+				break;
+			default:
+				break;
+			}
+
+			u32 width = m_size.x;
+			u32 height = (m_target == GL_TEXTURE_1D || m_target == GL_TEXTURE_1D_ARRAY) ? 1 : m_size.y;
+			u32 depth = mipDepth ? m_size.z : 1;
+
+			u64 size = 0;
+			for (u32 level = 0; level < levels; ++level)
+			{
+				size += getTextureFormatSize(m_textureFormat, std::max(width >> level, 1u), std::max(height >> level, 1u), std::max(depth >> level, 1u));
+			}
+
+			return size * layers * samples;
+		}
+
 		bool Texture::isSparseTexture() const
 		{
 			return m_formatData.get<0>();
@@ -920,5 +839,10 @@ namespace vx
 		{
 			return m_compressed != 0;
 		}
+
+		bool Texture::isView() const
+		{
+			return m_formatData.get<4>();
+		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,82 @@
+/*
+The MIT License(MIT)
+
+Copyright(c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/TextureFormat.h>
+#include <vxGL/gl.h>
+
+namespace vx
+{
+	namespace gl
+	{
+		constexpr TextureFormatTraits detail::TextureFormatTable::s_traits[];
+
+		u32 getPixelSize(TextureFormat format, DataType dataType)
+		{
+			auto &traits = getTextureFormatTraits(format);
+
+			u32 channelSize = 1;
+			switch (dataType)
+			{
+			case DataType::Byte:
+			case DataType::Unsigned_Byte:
+				channelSize = 1;
+				break;
+			case DataType::Short:
+			case DataType::Unsigned_Short:
+			case DataType::Half_Float:
+				channelSize = 2;
+				break;
+			case DataType::Int:
+			case DataType::Unsigned_Int:
+			case DataType::Float:
+				channelSize = 4;
+				break;
+			case DataType::Unsigned_Int_2_10_10_10_Rev:
+				// packed, all channels share one u32
+				return 4;
+			default:
+				VX_ASSERT(false);
+				break;
+			}
+
+			return traits.channels * channelSize;
+		}
+
+		u32 getTextureFormatPitch(TextureFormat format, u32 width)
+		{
+			auto &traits = getTextureFormatTraits(format);
+			auto blocksX = (width + traits.blockWidth - 1) / traits.blockWidth;
+
+			return blocksX * traits.bytesPerBlock;
+		}
+
+		u64 getTextureFormatSize(TextureFormat format, u32 width, u32 height, u32 depth)
+		{
+			auto &traits = getTextureFormatTraits(format);
+			u64 blocksY = (height + traits.blockHeight - 1) / traits.blockHeight;
+
+			return getTextureFormatPitch(format, width) * blocksY * depth;
+		}
+	}
+}
@@ -0,0 +1,185 @@
+/*
+The MIT License(MIT)
+
+Copyright(c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/TextureReadback.h>
+#include <vxGL/Texture.h>
+#include <vxGL/gl.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace vx
+{
+	namespace gl
+	{
+		TextureReadback::TextureReadback()
+			:m_buffer(),
+			m_fence(nullptr),
+			m_capacity(0),
+			m_size(0),
+			m_width(0),
+			m_height(0),
+			m_format(TextureFormat::RGBA8),
+			m_dataType(DataType::Unsigned_Byte)
+		{
+		}
+
+		TextureReadback::~TextureReadback()
+		{
+			release();
+		}
+
+		TextureReadback::TextureReadback(TextureReadback &&rhs)
+			:m_buffer(std::move(rhs.m_buffer)),
+			m_fence(rhs.m_fence),
+			m_capacity(rhs.m_capacity),
+			m_size(rhs.m_size),
+			m_width(rhs.m_width),
+			m_height(rhs.m_height),
+			m_format(rhs.m_format),
+			m_dataType(rhs.m_dataType)
+		{
+			rhs.m_fence = nullptr;
+			rhs.m_capacity = 0;
+			rhs.m_size = 0;
+		}
+
+		TextureReadback& TextureReadback::operator=(TextureReadback &&rhs)
+		{
+			if (this != &rhs)
+			{
+				std::swap(m_buffer, rhs.m_buffer);
+				std::swap(m_fence, rhs.m_fence);
+				std::swap(m_capacity, rhs.m_capacity);
+				std::swap(m_size, rhs.m_size);
+				std::swap(m_width, rhs.m_width);
+				std::swap(m_height, rhs.m_height);
+				std::swap(m_format, rhs.m_format);
+				std::swap(m_dataType, rhs.m_dataType);
+			}
+			return *this;
+		}
+
+		bool TextureReadback::request(const Texture &texture, u32 level, u32 layer)
+		{
+			// multisample textures can not be read with glGetTextureSubImage
+			auto target = texture.getTarget();
+			if (target == GL_TEXTURE_2D_MULTISAMPLE || target == GL_TEXTURE_2D_MULTISAMPLE_ARRAY)
+			{
+				printf("TextureReadback: multisample textures are not supported\n");
+				return false;
+			}
+
+			if (texture.isCompressed() || level >= texture.getMipLevels())
+			{
+				printf("TextureReadback: invalid texture or level\n");
+				return false;
+			}
+
+			auto &size = texture.getSize();
+			u32 width = std::max<u32>(size.x >> level, 1);
+			u32 height = std::max<u32>(size.y >> level, 1);
+			auto format = texture.getTextureFormat();
+			auto &traits = getTextureFormatTraits(format);
+			u64 dataSize = (u64)width * height * getPixelSize(format, traits.dataType);
+
+			if (m_fence)
+			{
+				glDeleteSync((GLsync)m_fence);
+				m_fence = nullptr;
+			}
+
+			if (dataSize > m_capacity)
+			{
+				m_buffer.destroy();
+				m_buffer = BufferDescription::createImmutable(BufferType::Pixel_Pack_Buffer, dataSize, BufferStorageFlags::Read, nullptr);
+				m_capacity = dataSize;
+			}
+
+			m_size = dataSize;
+			m_width = width;
+			m_height = height;
+			m_format = format;
+			m_dataType = traits.dataType;
+
+			s32 packAlignment = 4;
+			glGetIntegerv(GL_PACK_ALIGNMENT, &packAlignment);
+
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffer.getId());
+			glPixelStorei(GL_PACK_ALIGNMENT, 1);
+			glGetTextureSubImage(texture.getId(), level, 0, 0, layer, width, height, 1, traits.format, static_cast<u32>(traits.dataType), static_cast<GLsizei>(dataSize), nullptr);
+			glPixelStorei(GL_PACK_ALIGNMENT, packAlignment);
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+			m_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+			return true;
+		}
+
+		void TextureReadback::release()
+		{
+			if (m_fence)
+			{
+				glDeleteSync((GLsync)m_fence);
+				m_fence = nullptr;
+			}
+
+			m_buffer.destroy();
+			m_capacity = 0;
+			m_size = 0;
+		}
+
+		bool TextureReadback::isPending() const
+		{
+			return m_fence != nullptr;
+		}
+
+		bool TextureReadback::isReady() const
+		{
+			if (!m_fence)
+				return false;
+
+			auto result = glClientWaitSync((GLsync)m_fence, 0, 0);
+			return (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED);
+		}
+
+		bool TextureReadback::read(void* dst, u64 dstSize)
+		{
+			if (!m_fence || dstSize < m_size)
+				return false;
+
+			glClientWaitSync((GLsync)m_fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0xffffffffffffffffull);
+			glDeleteSync((GLsync)m_fence);
+			m_fence = nullptr;
+
+			auto mapped = m_buffer.mapRange<u8>(0, static_cast<u32>(m_size), MapRange::Read);
+			if (!mapped.isValid())
+				return false;
+
+			memcpy(dst, mapped.get(), m_size);
+
+			return true;
+		}
+	}
+}
\ No newline at end of file
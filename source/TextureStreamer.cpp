@@ -0,0 +1,382 @@
+/*
+The MIT License(MIT)
+
+Copyright(c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/TextureStreamer.h>
+#include <vxGL/gl.h>
+#include <cmath>
+#include <cstdio>
+
+namespace vx
+{
+	namespace gl
+	{
+		TextureStreamer::TextureStreamer()
+			:m_entries(),
+			m_freeEntries(),
+			m_candidates(),
+			m_memoryBudget(0),
+			m_memoryUsage(0),
+			m_maxUploadsPerUpdate(0),
+			m_frame(0),
+			m_loader(nullptr),
+			m_lodCallback(nullptr),
+			m_userData(nullptr),
+			m_clampTextureState(1)
+		{
+		}
+
+		TextureStreamer::~TextureStreamer()
+		{
+		}
+
+		void TextureStreamer::initialize(const TextureStreamerDescription &desc)
+		{
+			m_memoryBudget = desc.memoryBudget;
+			m_maxUploadsPerUpdate = desc.maxUploadsPerUpdate;
+			m_loader = desc.loader;
+			m_lodCallback = desc.lodCallback;
+			m_userData = desc.userData;
+			m_clampTextureState = desc.clampTextureState;
+		}
+
+		void TextureStreamer::shutdown()
+		{
+			m_entries.clear();
+			m_freeEntries.clear();
+			m_candidates.clear();
+			m_memoryUsage = 0;
+		}
+
+		u32 TextureStreamer::addTexture(const TextureDescription &desc, u32 tailLevels, u32 userId)
+		{
+			VX_ASSERT(desc.type == TextureType::Texture_2D || desc.type == TextureType::Texture_2D_Array);
+			VX_ASSERT(desc.miplevels >= 1);
+
+			u32 index;
+			if (m_freeEntries.empty())
+			{
+				index = static_cast<u32>(m_entries.size());
+				m_entries.push_back(Entry());
+			}
+			else
+			{
+				index = m_freeEntries.back();
+				m_freeEntries.pop_back();
+			}
+
+			auto sparseDesc = desc;
+			sparseDesc.sparse = 1;
+
+			auto &entry = m_entries[index];
+			entry.texture.create(sparseDesc);
+
+			// storage allocation fails if the format or size is not supported sparse
+			s32 immutable = 0;
+			s32 sparse = 0;
+			if (FLEXT_ARB_sparse_texture && entry.texture.isValid())
+			{
+				glGetTextureParameteriv(entry.texture.getId(), GL_TEXTURE_IMMUTABLE_FORMAT, &immutable);
+				glGetTextureParameteriv(entry.texture.getId(), GL_TEXTURE_SPARSE_ARB, &sparse);
+			}
+
+			if (immutable == 0 || sparse == 0)
+			{
+				printf("TextureStreamer: could not allocate sparse texture %u\n", userId);
+				entry.texture.destroy();
+				m_freeEntries.push_back(index);
+				return s_invalidIndex;
+			}
+
+			entry.userId = userId;
+			entry.lastRequestFrame = m_frame;
+			entry.miplevels = desc.miplevels;
+			entry.used = 1;
+
+			// levels in the mip tail can only be committed together
+			s32 sparseLevels = 0;
+			glGetTextureParameteriv(entry.texture.getId(), GL_NUM_SPARSE_LEVELS_ARB, &sparseLevels);
+
+			auto tailLevel = desc.miplevels - std::min<u32>(std::max<u32>(tailLevels, 1), desc.miplevels);
+			tailLevel = std::min<u32>(tailLevel, (u32)sparseLevels);
+			entry.tailLevel = tailLevel;
+			entry.residentLevel = desc.miplevels;
+			entry.requestedLevel = tailLevel;
+
+			for (u32 level = desc.miplevels; level > tailLevel; --level)
+			{
+				commitLevel(entry, level - 1, 1);
+				if (!loadLevel(entry, level - 1))
+				{
+					printf("TextureStreamer: could not load mip tail of texture %u\n", userId);
+
+					// the failed level and the ones loaded before it
+					for (u32 i = level - 1; i < desc.miplevels; ++i)
+					{
+						commitLevel(entry, i, 0);
+					}
+
+					for (u32 i = entry.residentLevel; i < desc.miplevels; ++i)
+					{
+						m_memoryUsage -= getLevelSize(entry, i);
+					}
+
+					entry.texture.destroy();
+					entry.used = 0;
+					m_freeEntries.push_back(index);
+					return s_invalidIndex;
+				}
+
+				entry.residentLevel = level - 1;
+				m_memoryUsage += getLevelSize(entry, level - 1);
+			}
+
+			clampLevel(entry);
+
+			return index;
+		}
+
+		void TextureStreamer::removeTexture(u32 index)
+		{
+			auto &entry = m_entries[index];
+			if (entry.used == 0)
+				return;
+
+			for (u32 level = entry.residentLevel; level < entry.miplevels; ++level)
+			{
+				m_memoryUsage -= getLevelSize(entry, level);
+			}
+
+			entry.texture.destroy();
+			entry.used = 0;
+			m_freeEntries.push_back(index);
+		}
+
+		void TextureStreamer::requestLevel(u32 index, u32 miplevel)
+		{
+			auto &entry = m_entries[index];
+			entry.requestedLevel = std::min<u32>(miplevel, entry.tailLevel);
+			entry.lastRequestFrame = m_frame;
+		}
+
+		void TextureStreamer::requestScreenSize(u32 index, f32 pixels)
+		{
+			auto &size = m_entries[index].texture.getSize();
+			auto textureSize = (f32)std::max(size.x, size.y);
+
+			u32 level = 0;
+			if (pixels > 0.0f && pixels < textureSize)
+			{
+				level = (u32)floorf(log2f(textureSize / pixels));
+			}
+			else if (pixels <= 0.0f)
+			{
+				level = 0xffff;
+			}
+
+			requestLevel(index, level);
+		}
+
+		void TextureStreamer::update()
+		{
+			// textures that are furthest away from their requested level go first
+			m_candidates.clear();
+			for (u32 i = 0; i < m_entries.size(); ++i)
+			{
+				auto &entry = m_entries[i];
+				if (entry.used != 0 && entry.requestedLevel < entry.residentLevel)
+				{
+					m_candidates.push_back(i);
+				}
+			}
+
+			std::sort(m_candidates.begin(), m_candidates.end(), [&](u32 l, u32 r)
+			{
+				auto &entryL = m_entries[l];
+				auto &entryR = m_entries[r];
+				return (entryL.residentLevel - entryL.requestedLevel) > (entryR.residentLevel - entryR.requestedLevel);
+			});
+
+			u32 uploads = 0;
+			for (auto index : m_candidates)
+			{
+				if (uploads >= m_maxUploadsPerUpdate)
+					break;
+
+				auto &entry = m_entries[index];
+				auto level = entry.residentLevel - 1u;
+				auto size = getLevelSize(entry, level);
+
+				if (m_memoryBudget != 0 && m_memoryUsage + size > m_memoryBudget && !makeRoom(size, index))
+					continue;
+
+				commitLevel(entry, level, 1);
+				if (!loadLevel(entry, level))
+				{
+					commitLevel(entry, level, 0);
+					continue;
+				}
+
+				entry.residentLevel = level;
+				m_memoryUsage += size;
+				clampLevel(entry);
+
+				++uploads;
+			}
+
+			++m_frame;
+		}
+
+		u64 TextureStreamer::getLevelSize(const Entry &entry, u32 level) const
+		{
+			auto &size = entry.texture.getSize();
+			u32 layers = (entry.texture.getTarget() == GL_TEXTURE_2D_ARRAY) ? size.z : 1;
+
+			return getTextureFormatSize(entry.texture.getTextureFormat(), std::max<u32>(size.x >> level, 1), std::max<u32>(size.y >> level, 1), layers);
+		}
+
+		bool TextureStreamer::loadLevel(Entry &entry, u32 level)
+		{
+			if (m_loader == nullptr)
+				return true;
+
+			TextureStreamerLevelData data;
+			data.p = nullptr;
+			data.dataType = getTextureFormatTraits(entry.texture.getTextureFormat()).dataType;
+			data.dataSize = 0;
+			if (!m_loader(entry.userId, level, &data, m_userData))
+				return false;
+
+			auto &size = entry.texture.getSize();
+			auto layers = (entry.texture.getTarget() == GL_TEXTURE_2D_ARRAY) ? size.z : 1u;
+			vx::uint3 levelSize = { std::max<u32>(size.x >> level, 1), std::max<u32>(size.y >> level, 1), layers };
+
+			if (entry.texture.isCompressed())
+			{
+				TextureCompressedSubImageDescription desc;
+				desc.miplevel = level;
+				desc.offset = vx::uint3{ 0, 0, 0 };
+				desc.size = levelSize;
+				desc.dataSize = data.dataSize;
+				desc.p = data.p;
+				entry.texture.subImageCompressed(desc);
+			}
+			else
+			{
+				TextureSubImageDescription desc;
+				desc.miplevel = level;
+				desc.offset = vx::uint3{ 0, 0, 0 };
+				desc.size = levelSize;
+				desc.dataType = data.dataType;
+				desc.p = data.p;
+				entry.texture.subImage(desc);
+			}
+
+			return true;
+		}
+
+		void TextureStreamer::commitLevel(Entry &entry, u32 level, u8 commit)
+		{
+			auto &size = entry.texture.getSize();
+
+			TextureCommitDescription desc;
+			desc.miplevel = level;
+			desc.offset = vx::uint3{ 0, 0, 0 };
+			desc.size.x = std::max<u32>(size.x >> level, 1);
+			desc.size.y = std::max<u32>(size.y >> level, 1);
+			desc.size.z = (entry.texture.getTarget() == GL_TEXTURE_2D_ARRAY) ? size.z : 1;
+			desc.commit = commit;
+
+			entry.texture.commit(desc);
+		}
+
+		void TextureStreamer::dropLevel(Entry &entry)
+		{
+			auto level = entry.residentLevel;
+			VX_ASSERT(level < entry.tailLevel);
+
+			// clamp first, so nothing samples the level after it has been decommitted
+			entry.residentLevel = level + 1;
+			clampLevel(entry);
+
+			commitLevel(entry, level, 0);
+			m_memoryUsage -= getLevelSize(entry, level);
+		}
+
+		void TextureStreamer::clampLevel(const Entry &entry) const
+		{
+			if (m_clampTextureState != 0)
+			{
+				auto id = entry.texture.getId();
+				glTextureParameteri(id, GL_TEXTURE_BASE_LEVEL, entry.residentLevel);
+				glTextureParameterf(id, GL_TEXTURE_MIN_LOD, (f32)entry.residentLevel);
+			}
+
+			if (m_lodCallback)
+			{
+				m_lodCallback(entry.userId, (f32)entry.residentLevel, m_userData);
+			}
+		}
+
+		bool TextureStreamer::makeRoom(u64 size, u32 requester)
+		{
+			auto &requesterEntry = m_entries[requester];
+			auto requesterDistance = requesterEntry.residentLevel - requesterEntry.requestedLevel;
+
+			while (m_memoryUsage + size > m_memoryBudget)
+			{
+				// drop the finest level of the texture that needs it least
+				u32 victim = 0xffffffff;
+				s32 victimScore = 0;
+				for (u32 i = 0; i < m_entries.size(); ++i)
+				{
+					auto &entry = m_entries[i];
+					if (i == requester || entry.used == 0 || entry.residentLevel >= entry.tailLevel)
+						continue;
+
+					// levels finer than requested are not needed at all, older requests go before recent ones
+					s32 score = (s32)entry.requestedLevel - (s32)entry.residentLevel;
+					score = score * 0x10000 + (s32)std::min<u32>(m_frame - entry.lastRequestFrame, 0xffff);
+					if (score > victimScore || victim == 0xffffffff)
+					{
+						victim = i;
+						victimScore = score;
+					}
+				}
+
+				if (victim == 0xffffffff)
+					return false;
+
+				// never drop a level that is needed more than the one we would upload
+				auto &victimEntry = m_entries[victim];
+				s32 victimDistance = (s32)victimEntry.residentLevel - (s32)victimEntry.requestedLevel + 1;
+				if (victimDistance > 0 && victimDistance >= requesterDistance)
+					return false;
+
+				dropLevel(victimEntry);
+			}
+
+			return true;
+		}
+	}
+}
@@ -0,0 +1,439 @@
+/*
+The MIT License(MIT)
+
+Copyright(c) 2015 Dennis Wandschura
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <vxGL/VirtualTexture.h>
+#include <vxGL/gl.h>
+#include <cstdio>
+
+namespace vx
+{
+	namespace gl
+	{
+		VirtualTexture::VirtualTexture()
+			:m_texture(),
+			m_feedbackBuffers(),
+			m_fences(),
+			m_mips(),
+			m_pages(),
+			m_committedPages(),
+			m_requests(),
+			m_size(),
+			m_pageSize(),
+			m_miplevels(0),
+			m_sparseLevels(0),
+			m_layers(0),
+			m_maxCommittedPages(0),
+			m_maxUploadsPerFrame(0),
+			m_feedbackCapacity(0),
+			m_feedbackIndex(0),
+			m_frame(0),
+			m_loader(nullptr),
+			m_userData(nullptr)
+		{
+		}
+
+		VirtualTexture::~VirtualTexture()
+		{
+			shutdown();
+		}
+
+		u32 VirtualTexture::makePageId(u32 miplevel, u32 layer, u32 x, u32 y)
+		{
+			return (x & 0x3ff) | ((y & 0x3ff) << 10) | ((miplevel & 0xf) << 20) | ((layer & 0xff) << 24);
+		}
+
+		bool VirtualTexture::initialize(const VirtualTextureDescription &desc)
+		{
+			VX_ASSERT(desc.type == TextureType::Texture_2D || desc.type == TextureType::Texture_2D_Array);
+
+			// page ids pack x and y into 10 bits, the miplevel into 4 bits and the layer into 8 bits
+			auto layers = (desc.type == TextureType::Texture_2D_Array) ? desc.size.z : 1u;
+			if (desc.miplevels > 16 || layers > 256)
+			{
+				printf("VirtualTexture: at most 16 miplevels and 256 layers are supported\n");
+				return false;
+			}
+
+			TextureDescription textureDesc;
+			textureDesc.type = desc.type;
+			textureDesc.format = desc.format;
+			textureDesc.size = desc.size;
+			textureDesc.miplevels = desc.miplevels;
+			textureDesc.sparse = 1;
+			m_texture.create(textureDesc);
+			if (!m_texture.isValid())
+				return false;
+
+			s32 pageSize[3] = {};
+			glGetInternalformativ(m_texture.getTarget(), m_texture.getInternalFormat(), GL_VIRTUAL_PAGE_SIZE_X_ARB, 1, &pageSize[0]);
+			glGetInternalformativ(m_texture.getTarget(), m_texture.getInternalFormat(), GL_VIRTUAL_PAGE_SIZE_Y_ARB, 1, &pageSize[1]);
+			glGetInternalformativ(m_texture.getTarget(), m_texture.getInternalFormat(), GL_VIRTUAL_PAGE_SIZE_Z_ARB, 1, &pageSize[2]);
+			if (pageSize[0] == 0 || pageSize[1] == 0)
+			{
+				printf("VirtualTexture: format not supported by sparse textures\n");
+				shutdown();
+				return false;
+			}
+
+			s32 sparseLevels = 0;
+			glGetTextureParameteriv(m_texture.getId(), GL_NUM_SPARSE_LEVELS_ARB, &sparseLevels);
+
+			if ((desc.size.x + pageSize[0] - 1) / pageSize[0] > 1024 || (desc.size.y + pageSize[1] - 1) / pageSize[1] > 1024)
+			{
+				printf("VirtualTexture: at most 1024x1024 pages are supported\n");
+				shutdown();
+				return false;
+			}
+
+			m_size = vx::uint3{ desc.size.x, desc.size.y, 1 };
+			m_pageSize = vx::uint3{ (u32)pageSize[0], (u32)pageSize[1], (u32)std::max(pageSize[2], 1) };
+			m_miplevels = desc.miplevels;
+			m_sparseLevels = std::min((u32)sparseLevels, m_miplevels);
+			m_layers = layers;
+			m_maxCommittedPages = desc.maxCommittedPages;
+			m_maxUploadsPerFrame = desc.maxUploadsPerFrame;
+			m_feedbackCapacity = desc.feedbackCapacity;
+			m_loader = desc.loader;
+			m_userData = desc.userData;
+
+			u32 pageCount = 0;
+			m_mips.reserve(m_sparseLevels);
+			for (u32 i = 0; i < m_sparseLevels; ++i)
+			{
+				auto width = std::max(m_size.x >> i, 1u);
+				auto height = std::max(m_size.y >> i, 1u);
+
+				MipInfo mip;
+				mip.pagesX = (width + m_pageSize.x - 1) / m_pageSize.x;
+				mip.pagesY = (height + m_pageSize.y - 1) / m_pageSize.y;
+				mip.firstPage = pageCount;
+				m_mips.push_back(mip);
+
+				pageCount += mip.pagesX * mip.pagesY * m_layers;
+			}
+
+			PageEntry emptyEntry;
+			emptyEntry.lastUsedFrame = 0;
+			emptyEntry.committed = 0;
+			m_pages.assign(pageCount, emptyEntry);
+
+			if (m_maxCommittedPages == 0)
+			{
+				m_maxCommittedPages = pageCount;
+			}
+			m_committedPages.reserve(m_maxCommittedPages);
+			m_requests.reserve(m_feedbackCapacity);
+
+			auto feedbackSize = sizeof(u32) * (m_feedbackCapacity + 1);
+			for (u32 i = 0; i < 2; ++i)
+			{
+				m_feedbackBuffers[i] = BufferDescription::createImmutable(BufferType::Shader_Storage_Buffer, feedbackSize, BufferStorageFlags::Dynamic_Storage, nullptr);
+
+				u32 zero = 0;
+				glClearNamedBufferData(m_feedbackBuffers[i].getId(), GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+			}
+
+			commitMipTail();
+
+			return true;
+		}
+
+		void VirtualTexture::shutdown()
+		{
+			for (u32 i = 0; i < 2; ++i)
+			{
+				if (m_fences[i])
+				{
+					glDeleteSync((GLsync)m_fences[i]);
+					m_fences[i] = nullptr;
+				}
+				m_feedbackBuffers[i].destroy();
+			}
+
+			m_texture.destroy();
+			m_mips.clear();
+			m_pages.clear();
+			m_committedPages.clear();
+			m_requests.clear();
+		}
+
+		void VirtualTexture::bindFeedbackBuffer(u32 bindingIndex) const
+		{
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, bindingIndex, m_feedbackBuffers[m_feedbackIndex].getId());
+		}
+
+		void VirtualTexture::update()
+		{
+			m_fences[m_feedbackIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			m_feedbackIndex ^= 1;
+
+			// the other buffer was written by the previous frame and gets reused by the next one
+			readFeedback(m_feedbackIndex);
+			processRequests();
+
+			++m_frame;
+		}
+
+		void VirtualTexture::requestPage(u32 miplevel, u32 layer, u32 x, u32 y)
+		{
+			m_requests.push_back(makePageId(miplevel, layer, x, y));
+		}
+
+		u32 VirtualTexture::getPageIndex(u32 miplevel, u32 layer, u32 x, u32 y) const
+		{
+			auto &mip = m_mips[miplevel];
+			return mip.firstPage + (layer * mip.pagesY + y) * mip.pagesX + x;
+		}
+
+		bool VirtualTexture::decodePageId(u32 pageId, u32* index) const
+		{
+			auto x = pageId & 0x3ff;
+			auto y = (pageId >> 10) & 0x3ff;
+			auto miplevel = (pageId >> 20) & 0xf;
+			auto layer = pageId >> 24;
+
+			if (miplevel >= m_sparseLevels || layer >= m_layers)
+				return false;
+
+			auto &mip = m_mips[miplevel];
+			if (x >= mip.pagesX || y >= mip.pagesY)
+				return false;
+
+			*index = getPageIndex(miplevel, layer, x, y);
+			return true;
+		}
+
+		void VirtualTexture::getPage(u32 pageId, VirtualTexturePage* page) const
+		{
+			auto x = pageId & 0x3ff;
+			auto y = (pageId >> 10) & 0x3ff;
+			page->miplevel = (pageId >> 20) & 0xf;
+			page->layer = pageId >> 24;
+
+			auto width = std::max(m_size.x >> page->miplevel, 1u);
+			auto height = std::max(m_size.y >> page->miplevel, 1u);
+
+			page->offset.x = x * m_pageSize.x;
+			page->offset.y = y * m_pageSize.y;
+			page->offset.z = page->layer;
+			page->size.x = std::min(m_pageSize.x, width - page->offset.x);
+			page->size.y = std::min(m_pageSize.y, height - page->offset.y);
+			page->size.z = 1;
+		}
+
+		void VirtualTexture::readFeedback(u32 bufferIndex)
+		{
+			auto &fence = m_fences[bufferIndex];
+			if (fence == nullptr)
+				return;
+
+			// usually already signaled, the buffer was submitted one frame ago
+			glClientWaitSync((GLsync)fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0xffffffffffffffffull);
+			glDeleteSync((GLsync)fence);
+			fence = nullptr;
+
+			auto bufferId = m_feedbackBuffers[bufferIndex].getId();
+
+			u32 count = 0;
+			glGetNamedBufferSubData(bufferId, 0, sizeof(u32), &count);
+			count = std::min(count, m_feedbackCapacity);
+
+			if (count != 0)
+			{
+				auto offset = m_requests.size();
+				m_requests.resize(offset + count);
+				glGetNamedBufferSubData(bufferId, sizeof(u32), sizeof(u32) * count, m_requests.data() + offset);
+			}
+
+			u32 zero = 0;
+			glClearNamedBufferSubData(bufferId, GL_R32UI, 0, sizeof(u32), GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+		}
+
+		void VirtualTexture::processRequests()
+		{
+			if (m_requests.empty())
+				return;
+
+			// coarse levels first, so there is always something to sample from
+			std::sort(m_requests.begin(), m_requests.end(), [](u32 l, u32 r)
+			{
+				return ((l >> 20) & 0xf) > ((r >> 20) & 0xf);
+			});
+
+			u32 uploads = 0;
+			for (auto pageId : m_requests)
+			{
+				u32 index;
+				if (!decodePageId(pageId, &index))
+					continue;
+
+				auto &entry = m_pages[index];
+				entry.lastUsedFrame = m_frame;
+
+				if (entry.committed != 0 || uploads >= m_maxUploadsPerFrame)
+					continue;
+
+				if (m_committedPages.size() >= m_maxCommittedPages && !evictPage())
+					continue;
+
+				if (commitPage(pageId, 1))
+				{
+					++uploads;
+				}
+			}
+
+			m_requests.clear();
+		}
+
+		bool VirtualTexture::evictPage()
+		{
+			u32 oldest = 0;
+			u32 oldestFrame = m_frame;
+			for (u32 i = 0; i < m_committedPages.size(); ++i)
+			{
+				u32 index;
+				decodePageId(m_committedPages[i], &index);
+
+				auto lastUsed = m_pages[index].lastUsedFrame;
+				if (lastUsed < oldestFrame)
+				{
+					oldestFrame = lastUsed;
+					oldest = i;
+				}
+			}
+
+			// everything was used this frame
+			if (oldestFrame == m_frame)
+				return false;
+
+			return commitPage(m_committedPages[oldest], 0);
+		}
+
+		bool VirtualTexture::commitPage(u32 pageId, u8 commit)
+		{
+			u32 index;
+			if (!decodePageId(pageId, &index))
+				return false;
+
+			VirtualTexturePage page;
+			getPage(pageId, &page);
+
+			TextureCommitDescription commitDesc;
+			commitDesc.miplevel = page.miplevel;
+			commitDesc.offset = page.offset;
+			commitDesc.size = page.size;
+			commitDesc.commit = commit;
+
+			if (commit != 0)
+			{
+				m_texture.commit(commitDesc);
+				if (!loadPage(page))
+				{
+					commitDesc.commit = 0;
+					m_texture.commit(commitDesc);
+					return false;
+				}
+
+				m_committedPages.push_back(pageId);
+			}
+			else
+			{
+				m_texture.commit(commitDesc);
+
+				auto it = std::find(m_committedPages.begin(), m_committedPages.end(), pageId);
+				if (it != m_committedPages.end())
+				{
+					*it = m_committedPages.back();
+					m_committedPages.pop_back();
+				}
+			}
+
+			m_pages[index].committed = commit;
+
+			return true;
+		}
+
+		bool VirtualTexture::loadPage(const VirtualTexturePage &page)
+		{
+			if (m_loader == nullptr)
+				return true;
+
+			VirtualTexturePageData data;
+			data.p = nullptr;
+			data.dataType = DataType::Unsigned_Byte;
+			data.dataSize = 0;
+			if (!m_loader(page, &data, m_userData))
+				return false;
+
+			if (m_texture.isCompressed())
+			{
+				TextureCompressedSubImageDescription desc;
+				desc.miplevel = page.miplevel;
+				desc.offset = page.offset;
+				desc.size = page.size;
+				desc.dataSize = data.dataSize;
+				desc.p = data.p;
+				m_texture.subImageCompressed(desc);
+			}
+			else
+			{
+				TextureSubImageDescription desc;
+				desc.miplevel = page.miplevel;
+				desc.offset = page.offset;
+				desc.size = page.size;
+				desc.dataType = data.dataType;
+				desc.p = data.p;
+				m_texture.subImage(desc);
+			}
+
+			return true;
+		}
+
+		void VirtualTexture::commitMipTail()
+		{
+			for (u32 level = m_sparseLevels; level < m_miplevels; ++level)
+			{
+				auto width = std::max(m_size.x >> level, 1u);
+				auto height = std::max(m_size.y >> level, 1u);
+
+				TextureCommitDescription commitDesc;
+				commitDesc.miplevel = level;
+				commitDesc.offset = vx::uint3{ 0, 0, 0 };
+				commitDesc.size = vx::uint3{ width, height, m_layers };
+				commitDesc.commit = 1;
+				m_texture.commit(commitDesc);
+
+				for (u32 layer = 0; layer < m_layers; ++layer)
+				{
+					VirtualTexturePage page;
+					page.miplevel = level;
+					page.layer = layer;
+					page.offset = vx::uint3{ 0, 0, layer };
+					page.size = vx::uint3{ width, height, 1 };
+					loadPage(page);
+				}
+			}
+		}
+	}
+}
@@ -1,5 +1,8 @@
 /* WARNING: This file was automatically generated */
 /* Do not edit. */
+/* NOTE: GL_KHR_parallel_shader_compile was added by hand (constants, glMaxShaderCompilerThreadsKHR,
+   FLEXT_KHR_parallel_shader_compile and its add_extension entry). Add
+   "extension KHR_parallel_shader_compile optional" to the profile before regenerating. */
 
 #include <vxGL/flextGL.h>
 
@@ -1163,6 +1166,11 @@ void flextLoadOpenGLFunctions(void)
 
 
 
+    /* GL_KHR_parallel_shader_compile */
+
+    glpfMaxShaderCompilerThreadsKHR = (PFNGLMAXSHADERCOMPILERTHREADSKHR_PROC*)get_proc("glMaxShaderCompilerThreadsKHR");
+
+
 }
 
 /* ----------------------- Extension flag definitions ---------------------- */
@@ -1185,6 +1193,7 @@ int FLEXT_NV_shader_buffer_load = GL_FALSE;
 int FLEXT_NV_conservative_raster = GL_FALSE;
 int FLEXT_NV_shader_atomic_fp16_vector = GL_FALSE;
 int FLEXT_NV_fill_rectangle = GL_FALSE;
+int FLEXT_KHR_parallel_shader_compile = GL_FALSE;
 
 /* ---------------------- Function pointer definitions --------------------- */
 
@@ -2175,6 +2184,10 @@ PFNGLPROGRAMUNIFORMUI64VNV_PROC* glpfProgramUniformui64vNV = NULL;
 
 PFNGLSUBPIXELPRECISIONBIASNV_PROC* glpfSubpixelPrecisionBiasNV = NULL;
 
+/* GL_KHR_parallel_shader_compile */
+
+PFNGLMAXSHADERCOMPILERTHREADSKHR_PROC* glpfMaxShaderCompilerThreadsKHR = NULL;
+
 
 
 static void add_extension(const char* extension)
@@ -2236,6 +2249,9 @@ static void add_extension(const char* extension)
     if (strcmp("GL_NV_fill_rectangle", extension) == 0) {
         FLEXT_NV_fill_rectangle = GL_TRUE;
     }
+    if (strcmp("GL_KHR_parallel_shader_compile", extension) == 0) {
+        FLEXT_KHR_parallel_shader_compile = GL_TRUE;
+    }
 }
 
 